@@ -0,0 +1,209 @@
+#include "BatchFactorizer.h"
+#include "GField.h"
+#include "GFNumber.h"
+#include <cassert>
+#include <thread>
+
+////////////////////////////////////  Constructors & Destructor  //////////////////////////////////
+
+/**
+ * Constructor
+ * @param threads number of worker threads, at least 1
+ * @param window number of chunks that may be read but not yet written, at least 1
+ */
+BatchFactorizer::BatchFactorizer(const int &threads, const int &window):_threads(threads),
+	_window(window), _read(0), _written(0), _lines(0), _finished(false),
+	_compact(false)
+{
+	assert(threads >= 1 && window >= 1);
+}
+
+
+////////////////////////////////////   Class Methods    ///////////////////////////////////////////
+
+/**
+ * Factors every line of the input and writes the results in input order
+ * @param parser the input, one number or n p l triple per line
+ * @param out the output
+ * @return number of lines read
+ */
+long BatchFactorizer::run(GFParser &parser, std::ostream &out)
+{
+	_chunks.clear();
+	_results.assign(_window, std::string());
+	_done.assign(_window, false);
+	_read = 0;
+	_written = 0;
+	_lines = 0;
+	_finished = false;
+
+	std::thread reader(&BatchFactorizer::_readInput, this, std::ref(parser));
+	std::vector<std::thread> workers;
+	for(int i = 0; i < _threads; i++)
+	{
+		workers.emplace_back(&BatchFactorizer::_work, this);
+	}
+	_writeOutput(out);
+
+	reader.join();
+	for(std::thread &worker : workers)
+	{
+		worker.join();
+	}
+	return _lines;
+}
+
+
+/**
+ * Factors one parsed line
+ * @param line a number or an n p l triple
+ * @param out receives the result line, nothing if the line is blank
+ * @return false if the line is malformed
+ */
+bool BatchFactorizer::factorLine(const GFParser::Line &line, GFFormatter &out)
+{
+	if(line.error != nullptr)
+	{
+		out.append("invalid input at byte ").append(line.errorOffset);
+		out.append(": ").append(line.error).append('\n');
+		return false;
+	}
+	if(line.count == 1)
+	{
+		GFNumber::printFactors(out, line.values[0]);
+	}
+	else if(line.count == 3)
+	{
+		GFNumber(line.values[0], GField(line.values[1], line.values[2])).printFactors(out);
+	}
+	return true;
+}
+
+
+/**
+ * Sets whether repeated prime factors are printed once with their exponent
+ * @param compact true for the p^e notation
+ */
+void BatchFactorizer::setCompact(const bool &compact)
+{
+	_compact = compact;
+}
+
+
+/**
+ * Returns the number of worker threads
+ * @return number of threads
+ */
+int BatchFactorizer::getThreads() const
+{
+	return _threads;
+}
+
+
+/**
+ * Returns the number of chunks that may be in flight
+ * @return the window
+ */
+int BatchFactorizer::getWindow() const
+{
+	return _window;
+}
+
+
+/**
+ * Reads the input into chunks, waiting while the window is full
+ * @param parser the input
+ */
+void BatchFactorizer::_readInput(GFParser &parser)
+{
+	while(true)
+	{
+		Chunk chunk;
+		chunk.lines.resize(CHUNK);
+		int count = 0;
+		while(count < CHUNK && parser.next(chunk.lines[count]))
+		{
+			count++;
+		}
+		chunk.lines.resize(count);
+		if(chunk.lines.empty())
+		{
+			break;
+		}
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		_slotFree.wait(lock, [this]{ return _read - _written < _window; });
+		_lines += chunk.lines.size();
+		chunk.index = _read++;
+		_chunks.push_back(std::move(chunk));
+		_chunkReady.notify_one();
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_finished = true;
+	_chunkReady.notify_all();
+	_resultReady.notify_all();
+}
+
+
+/**
+ * Factors queued chunks until the input ended and the queue is empty
+ */
+void BatchFactorizer::_work()
+{
+	GFFormatter result;
+	result.setCompact(_compact);
+	while(true)
+	{
+		Chunk chunk;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_chunkReady.wait(lock, [this]{ return !_chunks.empty() || _finished; });
+			if(_chunks.empty())
+			{
+				return;
+			}
+			chunk = std::move(_chunks.front());
+			_chunks.pop_front();
+		}
+
+		result.clear();
+		for(const GFParser::Line &line : chunk.lines)
+		{
+			factorLine(line, result);
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_results[chunk.index % _window].assign(result.data(), result.size());
+		_done[chunk.index % _window] = true;
+		_resultReady.notify_all();
+	}
+}
+
+
+/**
+ * Writes the results in input order until the last chunk was written
+ * @param out the output
+ */
+void BatchFactorizer::_writeOutput(std::ostream &out)
+{
+	std::string result;
+	for(long next = 0; ; next++)
+	{
+		const long slot = next % _window;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_resultReady.wait(lock, [this, next, slot]{ return _done[slot] || (_finished && next == _read); });
+			if(!_done[slot])
+			{
+				break;
+			}
+			result.swap(_results[slot]);
+			_done[slot] = false;
+			_written++;
+			_slotFree.notify_one();
+		}
+		out.write(result.data(), result.size());
+	}
+	out.flush();
+}
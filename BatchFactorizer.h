@@ -0,0 +1,137 @@
+#ifndef EX1_BATCHFACTORIZER_H
+#define EX1_BATCHFACTORIZER_H
+
+#include "GFFormatter.h"
+#include "GFParser.h"
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * This class factors a stream of numbers on a pool of worker threads.
+ * Every input line holds either a number n, which is factored as is, or a triple n p l, whose
+ * n is first reduced into GF(p^l); each is answered by one line n=p1*p2*..., as
+ * GFNumber::printFactors prints it. Blank lines are skipped and malformed ones answered with an
+ * error line giving the byte offset of the error.
+ * A reader thread parses the input with GFParser into chunks of lines, the workers factor whole
+ * chunks, and the calling thread writes the results back in input order. At most a fixed window of chunks is
+ * in flight between reading and writing, so memory stays bounded and a slow output stalls the
+ * reader instead of piling up results.
+ */
+class BatchFactorizer
+{
+
+public:
+
+	static const int CHUNK = 256;           // number of lines handed to a worker at once
+
+	static const int DEFAULT_WINDOW = 64;   // default number of chunks in flight
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor
+	 * @param threads number of worker threads, at least 1
+	 * @param window number of chunks that may be read but not yet written, at least 1
+	 */
+	BatchFactorizer(const int &threads, const int &window = DEFAULT_WINDOW);
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Factors every line of the input and writes the results in input order
+	 * @param parser the input, one number or n p l triple per line
+	 * @param out the output
+	 * @return number of lines read
+	 */
+	long run(GFParser &parser, std::ostream &out);
+
+	/**
+	 * Factors one parsed line
+	 * @param line a number or an n p l triple
+	 * @param out receives the result line, nothing if the line is blank
+	 * @return false if the line is malformed
+	 */
+	static bool factorLine(const GFParser::Line &line, GFFormatter &out);
+
+	/**
+	 * Sets whether repeated prime factors are printed once with their exponent
+	 * @param compact true for the p^e notation; the default is false
+	 */
+	void setCompact(const bool &compact);
+
+	/**
+	 * Returns the number of worker threads
+	 * @return number of threads
+	 */
+	int getThreads() const;
+
+	/**
+	 * Returns the number of chunks that may be in flight
+	 * @return the window
+	 */
+	int getWindow() const;
+
+
+private:
+
+	/**
+	 * A run of consecutive input lines
+	 */
+	struct Chunk
+	{
+		long index;                          // position of the chunk in the input
+		std::vector<GFParser::Line> lines;   // the parsed lines
+	};
+
+	int _threads;                         // number of worker threads
+
+	int _window;                          // number of chunks that may be in flight
+
+	std::mutex _mutex;                    // guards every member below
+
+	std::condition_variable _chunkReady;  // signaled when a chunk is queued or the input ended
+
+	std::condition_variable _resultReady; // signaled when a result is stored or the input ended
+
+	std::condition_variable _slotFree;    // signaled when a result was written
+
+	std::deque<Chunk> _chunks;            // chunks waiting for a worker
+
+	std::vector<std::string> _results;    // results by chunk index modulo the window
+
+	std::vector<bool> _done;              // whether the result of each slot is stored
+
+	long _read;                           // number of chunks read
+
+	long _written;                        // number of chunks written
+
+	long _lines;                          // number of lines read
+
+	bool _finished;                       // whether the input ended
+
+	bool _compact;                        // whether the p^e notation is used
+
+	/**
+	 * Reads the input into chunks, waiting while the window is full
+	 * @param parser the input
+	 */
+	void _readInput(GFParser &parser);
+
+	/**
+	 * Factors queued chunks until the input ended and the queue is empty
+	 */
+	void _work();
+
+	/**
+	 * Writes the results in input order until the last chunk was written
+	 * @param out the output
+	 */
+	void _writeOutput(std::ostream &out);
+};
+
+
+#endif //EX1_BATCHFACTORIZER_H
@@ -0,0 +1,789 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include <limits>
+#include "GFNumber.h"
+#include "GField.h"
+#include "GFBinary.h"
+#include "GFLogTable.h"
+#include "GFTransform.h"
+#include "GFMatrix.h"
+#include "GFVector.h"
+#include "FactorCache.h"
+#include "FactorStats.h"
+#include "PrimeSieve.h"
+
+// seed of every random input, so runs are comparable
+static const unsigned long SEED = 20240917;
+
+// largest batch benchmarkBatch runs
+static const long MAX_BATCH = 10000000;
+
+// sink which keeps the compiler from dropping benchmarked work
+static volatile long sink;
+
+#ifndef GF_ENABLE_STATS
+// number of heap allocations made so far, counted by the operator new below
+static std::atomic<long> allocations(0);
+#endif
+
+// whether the results are printed as JSON once every benchmark ran
+static bool json = false;
+
+// only benchmarks whose name contains this text run
+static std::string filter;
+
+// largest batch size benchmarkBatch runs, set by --max-batch
+static long maxBatch = MAX_BATCH;
+
+
+/**
+ * The cost of one operation
+ */
+struct Measurement
+{
+	long ops;                 // number of operations timed
+	double nsPerOp;           // nanoseconds per operation
+	double allocationsPerOp;  // heap allocations per operation
+};
+
+
+/**
+ * A named measurement, kept for the JSON output
+ */
+struct Result
+{
+	std::string name;         // name of the benchmark
+	Measurement measurement;  // what was measured
+};
+
+// every result reported so far
+static std::vector<Result> results;
+
+
+#ifndef GF_ENABLE_STATS
+/**
+ * Global operator new, counting every allocation of this program
+ * @param size number of bytes
+ * @return the allocated memory
+ */
+void* operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	void *memory = std::malloc(size ? size : 1);
+	if(memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+
+/**
+ * Global operator delete, matching the operator new above; kept out of line so the compiler
+ * does not pair the inlined free with a new expression
+ * @param memory memory from operator new
+ */
+__attribute__((noinline)) void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+
+/**
+ * Global sized operator delete, matching the operator new above
+ * @param memory memory from operator new
+ */
+__attribute__((noinline)) void operator delete(void *memory, size_t) noexcept
+{
+	std::free(memory);
+}
+#endif
+
+
+/**
+ * Returns the number of heap allocations made so far, counted by the operator new above or,
+ * with GF_ENABLE_STATS, by the one of FactorStats
+ * @return number of allocations
+ */
+static long allocationCount()
+{
+#ifdef GF_ENABLE_STATS
+	return (long)FactorStats::collect().get(FactorStats::ALLOCATIONS);
+#else
+	return allocations.load();
+#endif
+}
+
+
+/**
+ * Runs a function several times and measures the average time and allocations of one call
+ * @param calls number of calls
+ * @param function the benchmarked function, called with the index of the call
+ * @return the cost of one call
+ */
+template<typename Function>
+static Measurement timePerCall(const long& calls, Function function)
+{
+	const long allocated = allocationCount();
+	auto start = std::chrono::steady_clock::now();
+	for(long i = 0; i < calls; i++)
+	{
+		function(i);
+	}
+	auto end = std::chrono::steady_clock::now();
+	return {calls, std::chrono::duration<double, std::nano>(end - start).count() / calls,
+			(double)(allocationCount() - allocated) / calls};
+}
+
+
+/**
+ * Turns the cost of processing a batch into the cost of one item of it
+ * @param measurement the cost of one batch
+ * @param size number of items of a batch
+ * @return the cost of one item
+ */
+static Measurement perItem(const Measurement& measurement, const long& size)
+{
+	return {measurement.ops * size, measurement.nsPerOp / size, measurement.allocationsPerOp / size};
+}
+
+
+/**
+ * Check if a group of benchmarks has to run
+ * @param prefix the common start of the names of the group
+ * @return true if the filter may match a benchmark of the group
+ */
+static bool selected(const std::string& prefix)
+{
+	return prefix.find(filter) != std::string::npos || filter.compare(0, prefix.size(), prefix) == 0;
+}
+
+
+/**
+ * Prints one result line, or keeps the result for the JSON output
+ * @param name name of the benchmark
+ * @param measurement the cost of one operation
+ */
+static void report(const std::string& name, const Measurement& measurement)
+{
+	if(name.find(filter) == std::string::npos)
+	{
+		return;
+	}
+	results.push_back({name, measurement});
+	if(!json)
+	{
+		std::cout << name << ": " << measurement.nsPerOp << " ns/op, " << 1e9 / measurement.nsPerOp
+				  << " ops/s, " << measurement.allocationsPerOp << " allocations/op" << std::endl;
+	}
+}
+
+
+/**
+ * Prints every result as one JSON document
+ */
+static void printJson()
+{
+	std::cout << "{\n  \"seed\": " << SEED << ",\n  \"benchmarks\": [";
+	const char *separator = "\n";
+	for(const Result& result : results)
+	{
+		std::cout << separator << "    {\"name\": \"" << result.name << "\", \"ops\": "
+				  << result.measurement.ops << ", \"ns_per_op\": " << result.measurement.nsPerOp
+				  << ", \"ops_per_second\": " << 1e9 / result.measurement.nsPerOp
+				  << ", \"allocations_per_op\": " << result.measurement.allocationsPerOp << "}";
+		separator = ",\n";
+	}
+	std::cout << "\n  ]\n}" << std::endl;
+}
+
+
+/**
+ * Returns a random prime of an exact bit length
+ * @param random the generator
+ * @param bits the bit length, in [2, 62]
+ * @return the first prime at or after a random number with that bit length
+ */
+static long randomPrime(std::mt19937_64& random, const int& bits)
+{
+	long p = (long)(random() >> (65 - bits)) | (1L << (bits - 1)) | 1;
+	while(!GField::isPrime(p))
+	{
+		p += 2;
+	}
+	return p;
+}
+
+
+/**
+ * Compares sliding window and ladder exponentiation with repeated operator*= on full size
+ * exponents
+ * @param bits bit length of the modulus
+ * @param p a prime with that bit length
+ */
+static void benchmarkPower(const int& bits, const long& p)
+{
+	std::string prefix = "pow/" + std::to_string(bits) + "bit/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = 1000;
+	GField field(p);
+	std::mt19937_64 random(SEED);
+	std::vector<GFNumber> bases;
+	std::vector<long> exponents;
+	for(int i = 0; i < count; i++)
+	{
+		bases.push_back(field.createNumber((long)(random() >> 1)));
+		exponents.push_back((long)(random() >> 1) % (p - 1));
+	}
+
+	report(prefix + "sliding_window", timePerCall(count, [&](const long& i)
+	{
+		sink = bases[i].pow(exponents[i]).getNumber();
+	}));
+	report(prefix + "ladder", timePerCall(count, [&](const long& i)
+	{
+		sink = bases[i].powLadder(exponents[i]).getNumber();
+	}));
+	report(prefix + "square_and_multiply_operators", timePerCall(count, [&](const long& i)
+	{
+		GFNumber result = field.createNumber(1), base = bases[i];
+		for(long e = exponents[i]; e > 0; e >>= 1)
+		{
+			if(e & 1)
+			{
+				result *= base;
+			}
+			base *= base;
+		}
+		sink = result.getNumber();
+	}));
+}
+
+
+/**
+ * Measures the carry-less GF(2**l) multiplication, with PCLMUL where the CPU has it
+ * @param l degree of the binary field, in [2, 128]
+ */
+static void benchmarkBinary(const int& l)
+{
+	std::string prefix = "binary/GF(2**" + std::to_string(l) + ")/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = 100000;
+	GFBinary field(l);
+	const GFBinary::Element mask = (l == 128) ? ~(GFBinary::Element)0 :
+								   (((GFBinary::Element)1 << l) - 1);
+	std::mt19937_64 random(SEED);
+	std::vector<GFBinary::Element> elements;
+	for(int i = 0; i < count; i++)
+	{
+		elements.push_back((((GFBinary::Element)random() << 64) | random()) & mask);
+	}
+
+	report(prefix + (GFBinary::hasCarrylessMultiply() ? "multiply_pclmul" : "multiply_portable"),
+		   timePerCall(count - 1, [&](const long& i)
+		   {
+			   sink = (long)field.multiply(elements[i], elements[i + 1]);
+		   }));
+}
+
+
+/**
+ * Compares log table multiplication and inversion with the direct arithmetic of a small field.
+ * Runs with a zero budget first, so the direct numbers are measured before the field gets its
+ * tables; as the tables outgrow the caches the lookups lose their advantage.
+ * @param p p value of the field
+ * @param l l value of the field
+ */
+static void benchmarkLogTable(const long& p, const long& l)
+{
+	std::string prefix = "log_table/GF(" + std::to_string(p) + "**" + std::to_string(l) + ")/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = 100000;
+	GField field(p, l);
+	std::mt19937_64 random(SEED);
+	std::vector<long> numbers;
+	for(int i = 0; i < count; i++)
+	{
+		numbers.push_back(1 + (long)(random() % (unsigned long)(field.getOrder() - 1)));
+	}
+
+	auto run = [&](const std::string& prefix)
+	{
+		report(prefix + "multiply", timePerCall(count - 1, [&](const long& i)
+		{
+			sink = field.multiply(numbers[i], numbers[i + 1]);
+		}));
+		report(prefix + "inverse", timePerCall(count, [&](const long& i)
+		{
+			sink = field.inverse(numbers[i]);
+		}));
+	};
+
+	const size_t budget = GField::getLogTableBudget();
+	GField::setLogTableBudget(0);
+	run(prefix + "direct_");
+	GField::setLogTableBudget(std::numeric_limits<size_t>::max());
+	if(field.getLogTable() != nullptr)
+	{
+		run(prefix + "table_" + std::to_string(GFLogTable::bytesFor(field.getOrder())) + "B_");
+	}
+	GField::setLogTableBudget(budget);
+}
+
+
+/**
+ * Compares polynomial multiplication by the transform with the schoolbook loop over
+ * GFNumber::operator*, which only runs for the small sizes
+ * @param size number of coefficients of each polynomial
+ * @param p the char of the field; a transform prime takes one transform, others three and CRT
+ */
+static void benchmarkConvolution(const long& size, const long& p)
+{
+	std::string prefix = "convolution/" + std::to_string(size) + "/GF(" + std::to_string(p) + ")/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	GField field(p);
+	std::mt19937_64 random(SEED);
+	std::vector<long> a(size), b(size), product(2 * size - 1);
+	for(long i = 0; i < size; i++)
+	{
+		a[i] = (long)(random() % (unsigned long)p);
+		b[i] = (long)(random() % (unsigned long)p);
+	}
+
+	report(prefix + (GFTransform::isTransformField(field) ? "transform" : "transform_crt"),
+		   timePerCall(1, [&](const long&)
+		   {
+			   GFTransform::convolve(a.data(), size, b.data(), size, product.data(), field);
+			   sink = product[size];
+		   }));
+	if(size <= 4096)
+	{
+		report(prefix + "schoolbook", timePerCall(1, [&](const long&)
+		{
+			std::vector<GFNumber> result(2 * size - 1, field.createNumber(0));
+			std::vector<GFNumber> x, y;
+			for(long i = 0; i < size; i++)
+			{
+				x.push_back(field.createNumber(a[i]));
+				y.push_back(field.createNumber(b[i]));
+			}
+			for(long i = 0; i < size; i++)
+			{
+				for(long j = 0; j < size; j++)
+				{
+					result[i + j] += x[i] * y[j];
+				}
+			}
+			sink = result[size].getNumber();
+		}));
+	}
+}
+
+
+/**
+ * Times the blocked product, the Strassen product and the elimination of random square matrices
+ * @param size number of rows and columns
+ * @param p the char of the field
+ */
+static void benchmarkMatrix(const int& size, const long& p)
+{
+	std::string prefix = "matrix/" + std::to_string(size) + "/GF(" + std::to_string(p) + ")/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	GField field(p);
+	std::mt19937_64 random(SEED);
+	GFMatrix a(field, size, size), b(field, size, size);
+	for(int i = 0; i < size; i++)
+	{
+		for(int j = 0; j < size; j++)
+		{
+			a.set(i, j, (long)(random() >> 1));
+			b.set(i, j, (long)(random() >> 1));
+		}
+	}
+
+	const int threshold = GFMatrix::getStrassenThreshold();
+	GFMatrix::setStrassenThreshold(0);
+	report(prefix + "multiply_blocked", timePerCall(1, [&](const long&)
+	{
+		sink = (a * b).get(0, 0);
+	}));
+	GFMatrix::setStrassenThreshold(size / 4);
+	report(prefix + "multiply_strassen", timePerCall(1, [&](const long&)
+	{
+		sink = (a * b).get(0, 0);
+	}));
+	GFMatrix::setStrassenThreshold(threshold);
+	report(prefix + "rank", timePerCall(1, [&](const long&)
+	{
+		sink = a.rank();
+	}));
+}
+
+
+/**
+ * Times the factorization of 62 bit semiprimes, products of two 31 bit primes, with rho walks
+ * racing on several threads
+ * @param threads number of racing threads
+ */
+static void benchmarkRho(const int& threads)
+{
+	std::string prefix = "rho/62bit/threads" + std::to_string(threads);
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = 50;
+	std::mt19937_64 random(SEED);
+	std::vector<long> semiprimes;
+	for(int i = 0; i < count; i++)
+	{
+		semiprimes.push_back(randomPrime(random, 31) * randomPrime(random, 31));
+	}
+
+	const int previous = GFNumber::getRhoThreads();
+	GFNumber::setRhoThreads(threads);
+	FactorList factors;
+	report(prefix, timePerCall(count, [&](const long& i)
+	{
+		GFNumber::factorize(semiprimes[i], factors);
+		sink = factors.getPrime(0);
+	}));
+	GFNumber::setRhoThreads(previous);
+}
+
+
+/**
+ * Times the operators of GFNumber on random numbers of one field
+ * @param p p value of the field
+ * @param l l value of the field
+ */
+static void benchmarkArithmetic(const long& p, const long& l)
+{
+	std::string prefix = "arithmetic/GF(" + std::to_string(p) + "**" + std::to_string(l) + ")/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = 100000;
+	GField field(p, l);
+	std::mt19937_64 random(SEED);
+	std::vector<GFNumber> numbers;
+	for(int i = 0; i < count; i++)
+	{
+		numbers.push_back(field.createNumber(1 + (long)(random() % (unsigned long)(field.getOrder() - 1))));
+	}
+	// a negative long must act as the additive inverse of its absolute value in every field kind
+	const GFNumber &a = numbers[0];
+	for(const long k : {1L, 2L, p, field.getOrder() + 1})
+	{
+		if((a - (-k)).getNumber() != (a + k).getNumber() ||
+		   (a * (-k)).getNumber() != field.subtract(0, (a * k).getNumber()))
+		{
+			std::cerr << prefix << ": -" << k << " is not the additive inverse of " << k << std::endl;
+			exit(1);
+		}
+	}
+
+	report(prefix + "add", timePerCall(count - 1, [&](const long& i)
+	{
+		sink = (numbers[i] + numbers[i + 1]).getNumber();
+	}));
+	report(prefix + "multiply", timePerCall(count - 1, [&](const long& i)
+	{
+		sink = (numbers[i] * numbers[i + 1]).getNumber();
+	}));
+	report(prefix + "divide", timePerCall(count / 10, [&](const long& i)
+	{
+		sink = (numbers[i] / numbers[i + 1]).getNumber();
+	}));
+}
+
+
+/**
+ * Times GField::isPrime on random odd numbers and on primes of one bit length
+ * @param bits the bit length, in [3, 62]
+ */
+static void benchmarkPrimality(const int& bits)
+{
+	std::string prefix = "is_prime/" + std::to_string(bits) + "bit/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = 10000;
+	std::mt19937_64 random(SEED);
+	std::vector<long> odd, primes;
+	for(int i = 0; i < count; i++)
+	{
+		odd.push_back((long)(random() >> (65 - bits)) | (1L << (bits - 1)) | 1);
+		primes.push_back(randomPrime(random, bits));
+	}
+
+	report(prefix + "random_odd", timePerCall(count, [&](const long& i)
+	{
+		sink = GField::isPrime(odd[i]);
+	}));
+	report(prefix + "prime", timePerCall(count, [&](const long& i)
+	{
+		sink = GField::isPrime(primes[i]);
+	}));
+}
+
+
+/**
+ * Times the factorization of semiprimes, products of two primes of half the bit length
+ * @param bits the bit length of the semiprimes, even and in [8, 62]
+ */
+static void benchmarkSemiprimes(const int& bits)
+{
+	std::string prefix = "factorize/semiprime/" + std::to_string(bits) + "bit";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = (bits > 48) ? 100 : 1000;
+	std::mt19937_64 random(SEED);
+	std::vector<long> semiprimes;
+	for(int i = 0; i < count; i++)
+	{
+		semiprimes.push_back(randomPrime(random, bits / 2) * randomPrime(random, bits / 2));
+	}
+
+	FactorList factors;
+	report(prefix, timePerCall(count, [&](const long& i)
+	{
+		GFNumber::factorize(semiprimes[i], factors);
+		sink = factors.getPrime(0);
+	}));
+}
+
+
+/**
+ * Times counting and enumerating the primes of a range with the segmented sieve
+ * @param start start of the range
+ * @param length length of the range
+ */
+static void benchmarkSieve(const long& start, const long& length)
+{
+	std::string prefix = "sieve/" + std::to_string(start) + "+" + std::to_string(length) + "/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	report(prefix + "count", perItem(timePerCall(1, [&](const long&)
+	{
+		sink = PrimeSieve::countPrimes(start, start + length);
+	}), length));
+	report(prefix + "enumerate", perItem(timePerCall(1, [&](const long&)
+	{
+		long primes = 0;
+		PrimeSieve::primesInRange(start, start + length, [&primes](const long&)
+		{
+			primes++;
+		});
+		sink = primes;
+	}), length));
+}
+
+
+/**
+ * Times the factorization of 48 bit semiprimes through a factor cache, once when every number
+ * is cached and once when the cache is too small to keep any of them
+ */
+static void benchmarkCache()
+{
+	std::string prefix = "factorize/cache/";
+	if(!selected(prefix))
+	{
+		return;
+	}
+	const int count = 1000;
+	std::mt19937_64 random(SEED);
+	std::vector<long> semiprimes;
+	for(int i = 0; i < count; i++)
+	{
+		semiprimes.push_back(randomPrime(random, 24) * randomPrime(random, 24));
+	}
+
+	FactorList factors;
+	FactorCache large(1 << 20), small(0, 1);
+	GFNumber::setFactorCache(&large);
+	for(long n : semiprimes)
+	{
+		GFNumber::factorize(n, factors);
+	}
+	report(prefix + "hit", timePerCall(count, [&](const long& i)
+	{
+		GFNumber::factorize(semiprimes[i], factors);
+		sink = factors.getPrime(0);
+	}));
+	GFNumber::setFactorCache(&small);
+	report(prefix + "miss", timePerCall(count, [&](const long& i)
+	{
+		GFNumber::factorize(semiprimes[i], factors);
+		sink = factors.getPrime(0);
+	}));
+	GFNumber::setFactorCache(nullptr);
+}
+
+
+/**
+ * Times element wise products of batches of numbers of GF(2^31 - 1), with GFNumber::operator*
+ * and with GFVector, and the factorization of batches of 32 bit numbers; every pass runs over
+ * the whole batch so large batches measure memory rather than cache
+ * @param size number of numbers of a batch
+ */
+static void benchmarkBatch(const long& size)
+{
+	std::string prefix = "batch/" + std::to_string(size) + "/";
+	if(!selected(prefix) || size > maxBatch)
+	{
+		return;
+	}
+	const long p = 2147483647;
+	GField field(p);
+	std::mt19937_64 random(SEED);
+	std::vector<GFNumber> a, b, products(size);
+	GFVector x(field, (int)size), y(field, (int)size), z(field, (int)size);
+	for(long i = 0; i < size; i++)
+	{
+		a.push_back(field.createNumber((long)(random() % p)));
+		b.push_back(field.createNumber((long)(random() % p)));
+		x.set((int)i, a[i].getNumber());
+		y.set((int)i, b[i].getNumber());
+	}
+
+	const long passes = std::max(1L, MAX_BATCH / size);
+	report(prefix + "multiply_operator", perItem(timePerCall(passes, [&](const long&)
+	{
+		for(long i = 0; i < size; i++)
+		{
+			products[i] = a[i] * b[i];
+		}
+		sink = products[size - 1].getNumber();
+	}), size));
+	report(prefix + "multiply_vector", perItem(timePerCall(passes, [&](const long&)
+	{
+		z.multiply(x, y);
+		sink = z.get((int)size - 1);
+	}), size));
+
+	if(size <= 100000)
+	{
+		FactorList factors;
+		report(prefix + "factorize_32bit", perItem(timePerCall(std::max(1L, 100000 / size), [&](const long&)
+		{
+			for(long i = 0; i < size; i++)
+			{
+				GFNumber::factorize(x.get((int)i) | (1L << 31), factors);
+				sink = factors.getPrime(0);
+			}
+		}), size));
+	}
+}
+
+
+/**
+ * The main function of the benchmarks.
+ * Build: g++ -O2 -std=c++17 Benchmark.cpp GField.cpp GFNumber.cpp FactorList.cpp GFExtension.cpp
+ *        GFBinary.cpp GFLogTable.cpp GFTransform.cpp GFVector.cpp GFMatrix.cpp GFParser.cpp
+ *        GFFormatter.cpp FactorStats.cpp FactorCache.cpp PrimeSieve.cpp ThreadPool.cpp -pthread
+ *        -o benchmark
+ * Run: benchmark [--json] [--filter text] [--max-batch size]
+ * @return 0, or 1 for an unknown argument
+ */
+int main(int argc, char *argv[])
+{
+	for(int i = 1; i < argc; i++)
+	{
+		if(std::strcmp(argv[i], "--json") == 0)
+		{
+			json = true;
+		}
+		else if(std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else if(std::strcmp(argv[i], "--max-batch") == 0 && i + 1 < argc)
+		{
+			maxBatch = std::atol(argv[++i]);
+		}
+		else
+		{
+			std::cerr << "usage: " << argv[0] << " [--json] [--filter text] [--max-batch size]" << std::endl;
+			return 1;
+		}
+	}
+
+	benchmarkArithmetic(251, 1);
+	benchmarkArithmetic(2147483647, 1);
+	benchmarkArithmetic(2305843009213693951L, 1);
+	benchmarkArithmetic(3, 20);
+	benchmarkArithmetic(2, 40);
+	benchmarkPrimality(16);
+	benchmarkPrimality(31);
+	benchmarkPrimality(61);
+	benchmarkSemiprimes(32);
+	benchmarkSemiprimes(40);
+	benchmarkSemiprimes(48);
+	benchmarkSemiprimes(56);
+	benchmarkSemiprimes(62);
+	benchmarkCache();
+	benchmarkSieve(0, 1000000000L);
+	benchmarkSieve(1000000000000L, 100000000L);
+	for(long size = 1; size <= MAX_BATCH; size *= 10)
+	{
+		benchmarkBatch(size);
+	}
+	benchmarkPower(16, 65521);
+	benchmarkPower(32, 4294967291L);
+	benchmarkPower(64, 9223372036854775783L);
+	benchmarkBinary(62);
+	benchmarkBinary(64);
+	benchmarkBinary(128);
+	benchmarkLogTable(251, 1);
+	benchmarkLogTable(2, 8);
+	benchmarkLogTable(4093, 1);
+	benchmarkLogTable(3, 10);
+	benchmarkLogTable(65521, 1);
+	benchmarkLogTable(2, 16);
+	benchmarkConvolution(1000, 998244353);
+	benchmarkConvolution(4096, 998244353);
+	benchmarkConvolution(10000, 998244353);
+	benchmarkConvolution(100000, 998244353);
+	benchmarkConvolution(1000000, 998244353);
+	benchmarkConvolution(4096, 1000000007);
+	benchmarkConvolution(1000000, 1000000007);
+	benchmarkMatrix(512, 998244353);
+	benchmarkMatrix(1024, 998244353);
+	benchmarkRho(1);
+	benchmarkRho(2);
+	benchmarkRho(4);
+	if(json)
+	{
+		printJson();
+	}
+	return 0;
+}
@@ -0,0 +1,295 @@
+#include "FactorCache.h"
+#include <cassert>
+
+const int FactorCache::DEFAULT_SHARDS;
+
+// memory of a cached number besides its entry and factors: two list links, a hash node of
+// three words and a bucket
+static const size_t ENTRY_OVERHEAD = 6 * sizeof(void*);
+
+
+////////////////////////////////////  Constructors & Destructor  //////////////////////////////////
+
+/**
+ * Constructor
+ * @param bytes the most memory the cache may take, estimated
+ * @param shards number of shards, at least 1
+ */
+FactorCache::FactorCache(const size_t &bytes, const int &shards):_shards(shards), _capacity(bytes)
+{
+	assert(shards >= 1);
+	for(Shard &shard : _shards)
+	{
+		shard.bytes = 0;
+		shard.hits = 0;
+		shard.misses = 0;
+	}
+}
+
+
+////////////////////////////////////   Class Methods    ///////////////////////////////////////////
+
+/**
+ * Looks up the factorization of a number
+ * @param n a number
+ * @param factors receives the factorization if it is cached
+ * @return true if it is cached
+ */
+bool FactorCache::findFactors(const long &n, FactorList &factors)
+{
+	Shard &shard = _shardOf(n);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	const Entry *entry = _find(shard, n);
+	if(entry == nullptr || !entry->factorsKnown)
+	{
+		shard.misses++;
+		return false;
+	}
+	shard.hits++;
+	factors.clear();
+	const std::vector<long> &packed = entry->factors;
+	for(size_t i = 0; i < packed.size(); i++)
+	{
+		const bool repeated = i + 1 < packed.size() && packed[i + 1] < 0;
+		factors.add(packed[i], repeated ? (int)-packed[i + 1] : 1);
+		i += repeated;
+	}
+	return true;
+}
+
+
+/**
+ * Remembers the factorization of a number, and so whether it is prime
+ * @param n a number
+ * @param factors its factorization
+ */
+void FactorCache::insertFactors(const long &n, const FactorList &factors)
+{
+	Shard &shard = _shardOf(n);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	Entry &entry = _findOrAdd(shard, n);
+	shard.bytes -= _entryBytes(entry.factors.capacity());
+	entry.factors.clear();
+	for(int i = 0; i < factors.size(); i++)
+	{
+		entry.factors.push_back(factors.getPrime(i));
+		if(factors.getExponent(i) > 1)
+		{
+			entry.factors.push_back(-factors.getExponent(i));
+		}
+	}
+	entry.factors.shrink_to_fit();
+	entry.factorsKnown = true;
+	entry.primeKnown = true;
+	entry.prime = factors.count() == 1;
+	shard.bytes += _entryBytes(entry.factors.capacity());
+	_evict(shard);
+}
+
+
+/**
+ * Looks up whether a number is prime
+ * @param n a number
+ * @param prime receives the verdict if it is cached
+ * @return true if it is cached
+ */
+bool FactorCache::findPrime(const long &n, bool &prime)
+{
+	Shard &shard = _shardOf(n);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	const Entry *entry = _find(shard, n);
+	if(entry == nullptr || !entry->primeKnown)
+	{
+		shard.misses++;
+		return false;
+	}
+	shard.hits++;
+	prime = entry->prime;
+	return true;
+}
+
+
+/**
+ * Remembers whether a number is prime
+ * @param n a number
+ * @param prime the verdict
+ */
+void FactorCache::insertPrime(const long &n, const bool &prime)
+{
+	Shard &shard = _shardOf(n);
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	Entry &entry = _findOrAdd(shard, n);
+	entry.primeKnown = true;
+	entry.prime = prime;
+	_evict(shard);
+}
+
+
+/**
+ * Returns the number of lookups which found their number
+ * @return number of hits
+ */
+long FactorCache::getHits() const
+{
+	long hits = 0;
+	for(const Shard &shard : _shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		hits += shard.hits;
+	}
+	return hits;
+}
+
+
+/**
+ * Returns the number of lookups which did not find their number
+ * @return number of misses
+ */
+long FactorCache::getMisses() const
+{
+	long misses = 0;
+	for(const Shard &shard : _shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		misses += shard.misses;
+	}
+	return misses;
+}
+
+
+/**
+ * Returns the number of cached numbers
+ * @return number of entries
+ */
+long FactorCache::getEntries() const
+{
+	long entries = 0;
+	for(const Shard &shard : _shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		entries += (long)shard.index.size();
+	}
+	return entries;
+}
+
+
+/**
+ * Returns the estimated memory taken by the cached numbers
+ * @return number of bytes
+ */
+size_t FactorCache::getBytes() const
+{
+	size_t bytes = 0;
+	for(const Shard &shard : _shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		bytes += shard.bytes;
+	}
+	return bytes;
+}
+
+
+/**
+ * Returns the most memory the cache may take
+ * @return number of bytes
+ */
+size_t FactorCache::getCapacity() const
+{
+	return _capacity;
+}
+
+
+/**
+ * Forgets every number and zeroes the counters
+ */
+void FactorCache::clear()
+{
+	for(Shard &shard : _shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.entries.clear();
+		shard.index.clear();
+		shard.bytes = 0;
+		shard.hits = 0;
+		shard.misses = 0;
+	}
+}
+
+
+/**
+ * Returns the shard of a number
+ * @param n a number
+ * @return its shard
+ */
+FactorCache::Shard& FactorCache::_shardOf(const long &n)
+{
+	// Fibonacci hashing: the high bits of the product depend on every bit of n
+	const unsigned long hash = (unsigned long)n * 0x9E3779B97F4A7C15UL;
+	return _shards[(hash >> 32) % _shards.size()];
+}
+
+
+/**
+ * Finds a number in its locked shard and makes it the most recently used
+ * @param shard the shard of the number
+ * @param n the number
+ * @return the entry, or nullptr if the number is not cached
+ */
+FactorCache::Entry* FactorCache::_find(Shard &shard, const long &n)
+{
+	auto found = shard.index.find(n);
+	if(found == shard.index.end())
+	{
+		return nullptr;
+	}
+	shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+	return &*found->second;
+}
+
+
+/**
+ * Finds or adds a number in its locked shard and makes it the most recently used
+ * @param shard the shard of the number
+ * @param n the number
+ * @return the entry
+ */
+FactorCache::Entry& FactorCache::_findOrAdd(Shard &shard, const long &n)
+{
+	Entry *entry = _find(shard, n);
+	if(entry != nullptr)
+	{
+		return *entry;
+	}
+	shard.entries.push_front(Entry{n, false, false, false, std::vector<long>()});
+	shard.index.emplace(n, shard.entries.begin());
+	shard.bytes += _entryBytes(0);
+	return shard.entries.front();
+}
+
+
+/**
+ * Evicts the least recently used numbers of a locked shard until it fits its share
+ * @param shard the shard
+ */
+void FactorCache::_evict(Shard &shard)
+{
+	const size_t share = _capacity / _shards.size();
+	while(shard.bytes > share && shard.entries.size() > 1)
+	{
+		const Entry &last = shard.entries.back();
+		shard.bytes -= _entryBytes(last.factors.capacity());
+		shard.index.erase(last.n);
+		shard.entries.pop_back();
+	}
+}
+
+
+/**
+ * Returns the estimated memory taken by a cached number
+ * @param capacity number of words reserved for its factors
+ * @return number of bytes
+ */
+size_t FactorCache::_entryBytes(const size_t &capacity)
+{
+	return sizeof(Entry) + ENTRY_OVERHEAD + capacity * sizeof(long);
+}
@@ -0,0 +1,181 @@
+#ifndef EX1_FACTORCACHE_H
+#define EX1_FACTORCACHE_H
+
+#include "FactorList.h"
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * This class remembers the factorizations and primality verdicts of recently seen numbers.
+ * The numbers are spread over shards by a hash, each shard an LRU list with its own lock, so
+ * threads looking up different numbers rarely wait for each other. A factorization is kept
+ * compactly as its primes, each followed by its negated exponent when that is above 1. The
+ * memory of every shard is capped at an equal part of the capacity; the least recently used
+ * numbers are evicted first.
+ */
+class FactorCache
+{
+
+public:
+
+	static const int DEFAULT_SHARDS = 64;  // default number of shards
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor
+	 * @param bytes the most memory the cache may take, estimated
+	 * @param shards number of shards, at least 1
+	 */
+	explicit FactorCache(const size_t &bytes, const int &shards = DEFAULT_SHARDS);
+
+	FactorCache(const FactorCache &other) = delete;
+
+	FactorCache& operator=(const FactorCache &other) = delete;
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Looks up the factorization of a number
+	 * @param n a number
+	 * @param factors receives the factorization if it is cached
+	 * @return true if it is cached
+	 */
+	bool findFactors(const long &n, FactorList &factors);
+
+	/**
+	 * Remembers the factorization of a number, and so whether it is prime
+	 * @param n a number
+	 * @param factors its factorization
+	 */
+	void insertFactors(const long &n, const FactorList &factors);
+
+	/**
+	 * Looks up whether a number is prime
+	 * @param n a number
+	 * @param prime receives the verdict if it is cached
+	 * @return true if it is cached
+	 */
+	bool findPrime(const long &n, bool &prime);
+
+	/**
+	 * Remembers whether a number is prime
+	 * @param n a number
+	 * @param prime the verdict
+	 */
+	void insertPrime(const long &n, const bool &prime);
+
+	/**
+	 * Returns the number of lookups which found their number
+	 * @return number of hits
+	 */
+	long getHits() const;
+
+	/**
+	 * Returns the number of lookups which did not find their number
+	 * @return number of misses
+	 */
+	long getMisses() const;
+
+	/**
+	 * Returns the number of cached numbers
+	 * @return number of entries
+	 */
+	long getEntries() const;
+
+	/**
+	 * Returns the estimated memory taken by the cached numbers
+	 * @return number of bytes
+	 */
+	size_t getBytes() const;
+
+	/**
+	 * Returns the most memory the cache may take
+	 * @return number of bytes
+	 */
+	size_t getCapacity() const;
+
+	/**
+	 * Forgets every number and zeroes the counters
+	 */
+	void clear();
+
+
+private:
+
+	/**
+	 * A cached number
+	 */
+	struct Entry
+	{
+		long n;                     // the number
+		bool primeKnown;            // whether the primality verdict is known
+		bool prime;                 // the verdict
+		bool factorsKnown;          // whether the factorization is known
+		std::vector<long> factors;  // the primes, each followed by minus its exponent if above 1
+	};
+
+	/**
+	 * An LRU list of numbers with its own lock, aligned so shards do not share cache lines
+	 */
+	struct alignas(64) Shard
+	{
+		mutable std::mutex mutex;                                     // guards every member
+
+		std::list<Entry> entries;                                     // most recently used first
+
+		std::unordered_map<long, std::list<Entry>::iterator> index;   // entry of every number
+
+		size_t bytes;                                                 // estimated memory taken
+
+		long hits;                                                    // lookups which found
+
+		long misses;                                                  // lookups which did not
+	};
+
+	std::vector<Shard> _shards;  // the shards
+
+	size_t _capacity;            // the most memory the cache may take
+
+	/**
+	 * Returns the shard of a number
+	 * @param n a number
+	 * @return its shard
+	 */
+	Shard& _shardOf(const long &n);
+
+	/**
+	 * Finds a number in its locked shard and makes it the most recently used
+	 * @param shard the shard of the number
+	 * @param n the number
+	 * @return the entry, or nullptr if the number is not cached
+	 */
+	static Entry* _find(Shard &shard, const long &n);
+
+	/**
+	 * Finds or adds a number in its locked shard and makes it the most recently used
+	 * @param shard the shard of the number
+	 * @param n the number
+	 * @return the entry
+	 */
+	Entry& _findOrAdd(Shard &shard, const long &n);
+
+	/**
+	 * Evicts the least recently used numbers of a locked shard until it fits its share
+	 * @param shard the shard
+	 */
+	void _evict(Shard &shard);
+
+	/**
+	 * Returns the estimated memory taken by a cached number
+	 * @param capacity number of words reserved for its factors
+	 * @return number of bytes
+	 */
+	static size_t _entryBytes(const size_t &capacity);
+};
+
+
+#endif //EX1_FACTORCACHE_H
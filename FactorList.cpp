@@ -0,0 +1,104 @@
+#include "FactorList.h"
+#include <cassert>
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Default constructor - an empty list
+ */
+FactorList::FactorList():_size(0)
+{
+
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Adds a prime factor, merging it with an equal prime already in the list
+ * @param prime a prime number
+ * @param exponent the multiplicity of the prime
+ */
+void FactorList::add(const long& prime, const int& exponent)
+{
+	int i = _size;
+	while(i > 0 && _primes[i - 1] > prime)
+	{
+		i--;
+	}
+	if(i > 0 && _primes[i - 1] == prime)
+	{
+		_exponents[i - 1] += exponent;
+		return;
+	}
+
+	assert(_size < CAPACITY);
+	for(int j = _size; j > i; j--)
+	{
+		_primes[j] = _primes[j - 1];
+		_exponents[j] = _exponents[j - 1];
+	}
+	_primes[i] = prime;
+	_exponents[i] = exponent;
+	_size++;
+}
+
+
+/**
+ * Removes every factor from the list
+ */
+void FactorList::clear()
+{
+	_size = 0;
+}
+
+
+/**
+ * Returns the number of distinct primes in the list
+ * @return number of distinct primes
+ */
+int FactorList::size() const
+{
+	return _size;
+}
+
+
+/**
+ * Returns the number of prime factors counted with multiplicity
+ * @return sum of the exponents
+ */
+int FactorList::count() const
+{
+	int total = 0;
+	for(int i = 0; i < _size; i++)
+	{
+		total += _exponents[i];
+	}
+	return total;
+}
+
+
+/**
+ * Returns the i'th prime of the list, in increasing order
+ * @param i an index in [0, size())
+ * @return the i'th prime
+ */
+const long& FactorList::getPrime(const int& i) const
+{
+	assert(i >= 0 && i < _size);
+	return _primes[i];
+}
+
+
+/**
+ * Returns the exponent of the i'th prime of the list
+ * @param i an index in [0, size())
+ * @return the exponent of the i'th prime
+ */
+const int& FactorList::getExponent(const int& i) const
+{
+	assert(i >= 0 && i < _size);
+	return _exponents[i];
+}
@@ -0,0 +1,74 @@
+#ifndef EX1_FACTORLIST_H
+#define EX1_FACTORLIST_H
+
+/**
+ * This class represents the prime factorization of a number as (prime, exponent) pairs sorted
+ * by prime. It has a fixed capacity and lives on the stack, so filling it never allocates:
+ * a 64 bit number has at most 64 prime factors.
+ */
+class FactorList
+{
+
+public:
+
+	static const int CAPACITY = 64;  // maximal number of distinct primes
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Default constructor - an empty list
+	 */
+	FactorList();
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Adds a prime factor, merging it with an equal prime already in the list
+	 * @param prime a prime number
+	 * @param exponent the multiplicity of the prime
+	 */
+	void add(const long& prime, const int& exponent = 1);
+
+	/**
+	 * Removes every factor from the list
+	 */
+	void clear();
+
+	/**
+	 * Returns the number of distinct primes in the list
+	 * @return number of distinct primes
+	 */
+	int size() const;
+
+	/**
+	 * Returns the number of prime factors counted with multiplicity
+	 * @return sum of the exponents
+	 */
+	int count() const;
+
+	/**
+	 * Returns the i'th prime of the list, in increasing order
+	 * @param i an index in [0, size())
+	 * @return the i'th prime
+	 */
+	const long& getPrime(const int& i) const;
+
+	/**
+	 * Returns the exponent of the i'th prime of the list
+	 * @param i an index in [0, size())
+	 * @return the exponent of the i'th prime
+	 */
+	const int& getExponent(const int& i) const;
+
+
+private:
+
+	long _primes[CAPACITY];    // distinct primes in increasing order
+
+	int _exponents[CAPACITY];  // exponent of every prime
+
+	int _size;                 // number of distinct primes
+};
+
+
+#endif //EX1_FACTORLIST_H
@@ -0,0 +1,367 @@
+#include "FactorStats.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// names of the counters, in the order of FactorStats::Counter
+static const char *COUNTER_NAMES[] = {"factorize_calls", "factorize_nanoseconds", "is_prime_calls",
+									  "is_prime_nanoseconds", "trial_divisions", "rho_walks",
+									  "rho_iterations", "rho_restarts", "rho_failures", "fallbacks",
+									  "allocations", "rho_threads"};
+
+
+/**
+ * The counts of one thread. Only the owning thread writes them, with plain loads and stores;
+ * they are atomic so collect may read them while the thread runs.
+ */
+struct StatsBlock
+{
+	std::atomic<unsigned long> counters[FactorStats::COUNTERS];  // the counts
+
+	std::atomic<unsigned long> latencies[FactorStats::MAX_BITS + 1][FactorStats::BUCKETS];  // histogram
+
+	/**
+	 * Constructor - a zero block, registered for collect
+	 */
+	StatsBlock();
+
+	/**
+	 * Destructor - adds the counts to the ones of finished threads and unregisters
+	 */
+	~StatsBlock();
+
+	/**
+	 * Adds the counts of this block to merged counts
+	 * @param stats the merged counts
+	 */
+	void mergeInto(FactorStats &stats) const;
+};
+
+
+/**
+ * The blocks of the running threads and the merged counts of the finished ones
+ */
+struct Registry
+{
+	std::mutex mutex;              // guards both members
+
+	std::vector<StatsBlock*> blocks;    // blocks of the running threads
+
+	FactorStats finished;          // counts of the finished threads
+};
+
+
+/**
+ * Returns the registry, built on first use
+ * @return the registry
+ */
+static Registry& registry()
+{
+	static Registry *instance = new Registry();  // never destroyed, threads may exit after main
+	return *instance;
+}
+
+
+// the block of the calling thread, once it is built and until it is destroyed
+static thread_local StatsBlock *currentBlock = nullptr;
+
+// whether the block of the calling thread is being built or was destroyed, so that the
+// allocations this makes are not counted into a block which does not exist
+static thread_local bool blockUnavailable = false;
+
+
+/**
+ * Returns the block of the calling thread
+ * @return the block
+ */
+static StatsBlock& localBlock()
+{
+	thread_local StatsBlock block;
+	return block;
+}
+
+
+/**
+ * Adds to a counter of the calling thread
+ * @param counter a counter
+ * @param amount the amount
+ */
+static inline void increase(std::atomic<unsigned long> &counter, const unsigned long &amount)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+
+/**
+ * Constructor - a zero block, registered for collect
+ */
+StatsBlock::StatsBlock()
+{
+	blockUnavailable = true;
+	for(std::atomic<unsigned long> &counter : counters)
+	{
+		counter.store(0, std::memory_order_relaxed);
+	}
+	for(auto &row : latencies)
+	{
+		for(std::atomic<unsigned long> &bucket : row)
+		{
+			bucket.store(0, std::memory_order_relaxed);
+		}
+	}
+	{
+		std::lock_guard<std::mutex> lock(registry().mutex);
+		registry().blocks.push_back(this);
+	}
+	currentBlock = this;
+	blockUnavailable = false;
+}
+
+
+/**
+ * Destructor - adds the counts to the ones of finished threads and unregisters
+ */
+StatsBlock::~StatsBlock()
+{
+	currentBlock = nullptr;
+	blockUnavailable = true;
+	Registry &shared = registry();
+	std::lock_guard<std::mutex> lock(shared.mutex);
+	mergeInto(shared.finished);
+	for(size_t i = 0; i < shared.blocks.size(); i++)
+	{
+		if(shared.blocks[i] == this)
+		{
+			shared.blocks[i] = shared.blocks.back();
+			shared.blocks.pop_back();
+			break;
+		}
+	}
+}
+
+
+/**
+ * Adds the counts of this block to merged counts
+ * @param stats the merged counts
+ */
+void StatsBlock::mergeInto(FactorStats &stats) const
+{
+	for(int i = 0; i < FactorStats::COUNTERS; i++)
+	{
+		stats._counters[i] += counters[i].load(std::memory_order_relaxed);
+	}
+	for(int bits = 0; bits <= FactorStats::MAX_BITS; bits++)
+	{
+		for(int bucket = 0; bucket < FactorStats::BUCKETS; bucket++)
+		{
+			stats._latencies[bits][bucket] += latencies[bits][bucket].load(std::memory_order_relaxed);
+		}
+	}
+}
+
+
+////////////////////////////////////  Constructors & Destructor  //////////////////////////////////
+
+/**
+ * Default constructor - every count is zero
+ */
+FactorStats::FactorStats()
+{
+	memset(_counters, 0, sizeof(_counters));
+	memset(_latencies, 0, sizeof(_latencies));
+}
+
+
+////////////////////////////////////   Class Methods    ///////////////////////////////////////////
+
+/**
+ * Check if the statistics are compiled in
+ * @return true if GF_ENABLE_STATS was defined
+ */
+bool FactorStats::isEnabled()
+{
+#ifdef GF_ENABLE_STATS
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+/**
+ * Merges the counts of every thread, running or finished
+ * @return the merged counts
+ */
+FactorStats FactorStats::collect()
+{
+	Registry &shared = registry();
+	std::lock_guard<std::mutex> lock(shared.mutex);
+	FactorStats stats = shared.finished;
+	for(const StatsBlock *block : shared.blocks)
+	{
+		block->mergeInto(stats);
+	}
+	return stats;
+}
+
+
+/**
+ * Sets every count of every thread to zero; events counted meanwhile may survive
+ */
+void FactorStats::reset()
+{
+	Registry &shared = registry();
+	std::lock_guard<std::mutex> lock(shared.mutex);
+	shared.finished = FactorStats();
+	for(StatsBlock *block : shared.blocks)
+	{
+		for(std::atomic<unsigned long> &counter : block->counters)
+		{
+			counter.store(0, std::memory_order_relaxed);
+		}
+		for(auto &row : block->latencies)
+		{
+			for(std::atomic<unsigned long> &bucket : row)
+			{
+				bucket.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
+
+
+/**
+ * Returns a count
+ * @param counter the counter
+ * @return the count
+ */
+const unsigned long& FactorStats::get(const Counter &counter) const
+{
+	assert(counter >= 0 && counter < COUNTERS);
+	return _counters[counter];
+}
+
+
+/**
+ * Returns a count of the latency histogram
+ * @param bits bit length of the inputs, in [0, MAX_BITS]
+ * @param bucket the bucket, in [0, BUCKETS)
+ * @return number of inputs of that bit length factored in [2^bucket, 2^(bucket+1)) ns
+ */
+const unsigned long& FactorStats::getLatency(const int &bits, const int &bucket) const
+{
+	assert(bits >= 0 && bits <= MAX_BITS && bucket >= 0 && bucket < BUCKETS);
+	return _latencies[bits][bucket];
+}
+
+
+/**
+ * Returns the name of a counter
+ * @param counter the counter
+ * @return its name
+ */
+const char* FactorStats::getName(const Counter &counter)
+{
+	assert(counter >= 0 && counter < COUNTERS);
+	return COUNTER_NAMES[counter];
+}
+
+
+/**
+ * Prints every counter and the non empty buckets of the histogram, one line each
+ * @param out the output
+ */
+void FactorStats::print(std::ostream &out) const
+{
+	for(int i = 0; i < COUNTERS; i++)
+	{
+		out << COUNTER_NAMES[i] << ": " << _counters[i] << '\n';
+	}
+	for(int bits = 0; bits <= MAX_BITS; bits++)
+	{
+		for(int bucket = 0; bucket < BUCKETS; bucket++)
+		{
+			if(_latencies[bits][bucket] != 0)
+			{
+				out << "latency/" << bits << "bit/" << (1UL << bucket) << "ns: " << _latencies[bits][bucket]
+					<< '\n';
+			}
+		}
+	}
+	out.flush();
+}
+
+
+/**
+ * Counts events in the block of the calling thread
+ * @param counter the counter
+ * @param amount number of events
+ */
+void FactorStats::_add(const Counter &counter, const unsigned long &amount)
+{
+	increase(localBlock().counters[counter], amount);
+}
+
+
+/**
+ * Counts one factorization in the latency histogram of the calling thread
+ * @param bits bit length of the input
+ * @param nanoseconds time it took
+ */
+void FactorStats::_addLatency(const int &bits, const unsigned long &nanoseconds)
+{
+	const int bucket = (nanoseconds == 0) ? 0 : std::min(BUCKETS - 1, 63 - __builtin_clzl(nanoseconds));
+	increase(localBlock().latencies[bits][bucket], 1);
+}
+
+
+#ifdef GF_ENABLE_STATS
+/**
+ * Global operator new, counting every allocation in the block of the calling thread
+ * @param size number of bytes
+ * @return the allocated memory
+ */
+void* operator new(size_t size)
+{
+	if(currentBlock == nullptr && !blockUnavailable)
+	{
+		localBlock();  // builds the block, which sets currentBlock
+	}
+	if(currentBlock != nullptr)
+	{
+		increase(currentBlock->counters[FactorStats::ALLOCATIONS], 1);
+	}
+	void *memory = std::malloc(size ? size : 1);
+	if(memory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+
+/**
+ * Global operator delete, matching the operator new above; kept out of line so the compiler
+ * does not pair the inlined free with a new expression
+ * @param memory memory from operator new
+ */
+__attribute__((noinline)) void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+
+/**
+ * Global sized operator delete, matching the operator new above
+ * @param memory memory from operator new
+ */
+__attribute__((noinline)) void operator delete(void *memory, size_t) noexcept
+{
+	std::free(memory);
+}
+#endif
@@ -0,0 +1,193 @@
+#ifndef EX1_FACTORSTATS_H
+#define EX1_FACTORSTATS_H
+
+#include <chrono>
+#include <iostream>
+
+/**
+ * This class counts what the factorization pipeline does: primality tests, rho walks and
+ * their iterations, restarts and failures, trial divisions, fallbacks to trial division, heap
+ * allocations, racer threads of parallel rho, and a histogram of factorization latencies per bit
+ * length of the input.
+ * Counting is compiled in only when GF_ENABLE_STATS is defined; otherwise add and Timer are
+ * empty inline functions and cost nothing. With it, FactorStats.cpp replaces the global
+ * operator new to count allocations, so a program may not replace it too. Every thread counts into its own block, without
+ * locks or atomic read-modify-writes, and collect merges the blocks on demand.
+ */
+class FactorStats
+{
+
+public:
+
+	/**
+	 * The counted events
+	 */
+	enum Counter
+	{
+		FACTORIZE_CALLS,        // numbers factored
+		FACTORIZE_NANOSECONDS,  // time spent factoring them
+		IS_PRIME_CALLS,         // primality tests
+		IS_PRIME_NANOSECONDS,   // time spent in primality tests
+		TRIAL_DIVISIONS,        // candidates tried by trial division
+		RHO_WALKS,              // rho walks started
+		RHO_ITERATIONS,         // steps of every rho walk together
+		RHO_RESTARTS,           // rho walks which failed, so another polinom was tried
+		RHO_FAILURES,           // composites on which every rho attempt failed
+		FALLBACKS,              // composites split by trial division up to their square root
+		ALLOCATIONS,            // calls of the global operator new, by any code of the thread
+		RHO_THREADS,            // racer threads started by parallel rho walks
+		COUNTERS                // number of counters
+	};
+
+	static const int MAX_BITS = 64;  // largest bit length of the latency histogram
+
+	static const int BUCKETS = 40;   // latency bucket k counts times in [2^k, 2^(k+1)) nanoseconds
+
+	/**
+	 * Measures the time of a scope and adds it to a counter, and to the latency histogram
+	 */
+	class Timer
+	{
+
+	public:
+
+#ifdef GF_ENABLE_STATS
+		/**
+		 * Constructor - starts the clock
+		 * @param counter the counter receiving the nanoseconds
+		 * @param bits bit length of the input for the latency histogram, -1 to leave it out
+		 */
+		explicit Timer(const Counter &counter, const int &bits = -1):_counter(counter), _bits(bits),
+			_start(std::chrono::steady_clock::now())
+		{
+
+		}
+
+		/**
+		 * Destructor - stops the clock and counts the time
+		 */
+		~Timer()
+		{
+			const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - _start;
+			const unsigned long nanoseconds = (unsigned long)elapsed.count();
+			_add(_counter, nanoseconds);
+			if(_bits >= 0)
+			{
+				_addLatency(_bits, nanoseconds);
+			}
+		}
+
+
+	private:
+
+		Counter _counter;                               // the counter receiving the time
+
+		int _bits;                                      // bit length of the input, or -1
+
+		std::chrono::steady_clock::time_point _start;   // when the scope started
+#else
+		/**
+		 * Constructor - does nothing, statistics are compiled out
+		 */
+		explicit Timer(const Counter &, const int & = -1)
+		{
+
+		}
+#endif
+	};
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Default constructor - every count is zero
+	 */
+	FactorStats();
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Counts events in the block of the calling thread
+	 * @param counter the counter
+	 * @param amount number of events
+	 */
+	static void add(const Counter &counter, const unsigned long &amount = 1)
+	{
+#ifdef GF_ENABLE_STATS
+		_add(counter, amount);
+#else
+		(void)counter;
+		(void)amount;
+#endif
+	}
+
+	/**
+	 * Check if the statistics are compiled in
+	 * @return true if GF_ENABLE_STATS was defined
+	 */
+	static bool isEnabled();
+
+	/**
+	 * Merges the counts of every thread, running or finished
+	 * @return the merged counts
+	 */
+	static FactorStats collect();
+
+	/**
+	 * Sets every count of every thread to zero; events counted meanwhile may survive
+	 */
+	static void reset();
+
+	/**
+	 * Returns a count
+	 * @param counter the counter
+	 * @return the count
+	 */
+	const unsigned long& get(const Counter &counter) const;
+
+	/**
+	 * Returns a count of the latency histogram
+	 * @param bits bit length of the inputs, in [0, MAX_BITS]
+	 * @param bucket the bucket, in [0, BUCKETS)
+	 * @return number of inputs of that bit length factored in [2^bucket, 2^(bucket+1)) ns
+	 */
+	const unsigned long& getLatency(const int &bits, const int &bucket) const;
+
+	/**
+	 * Returns the name of a counter
+	 * @param counter the counter
+	 * @return its name
+	 */
+	static const char* getName(const Counter &counter);
+
+	/**
+	 * Prints every counter and the non empty buckets of the histogram, one line each
+	 * @param out the output
+	 */
+	void print(std::ostream &out) const;
+
+
+private:
+
+	friend struct StatsBlock;
+
+	unsigned long _counters[COUNTERS];                  // the counts
+
+	unsigned long _latencies[MAX_BITS + 1][BUCKETS];   // the latency histogram, by bit length
+
+	/**
+	 * Counts events in the block of the calling thread
+	 * @param counter the counter
+	 * @param amount number of events
+	 */
+	static void _add(const Counter &counter, const unsigned long &amount);
+
+	/**
+	 * Counts one factorization in the latency histogram of the calling thread
+	 * @param bits bit length of the input
+	 * @param nanoseconds time it took
+	 */
+	static void _addLatency(const int &bits, const unsigned long &nanoseconds);
+};
+
+
+#endif //EX1_FACTORSTATS_H
@@ -0,0 +1,375 @@
+#include "GFBinary.h"
+#include <cassert>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+typedef GFBinary::Element Element;
+
+
+/**
+ * Returns the degree of a bit polynomial
+ * @param a a bit polynomial
+ * @return its degree, or -1 for zero
+ */
+static int degreeOf(const Element &a)
+{
+	const unsigned long high = (unsigned long)(a >> 64), low = (unsigned long)a;
+	if(high != 0)
+	{
+		return 127 - __builtin_clzl(high);
+	}
+	return (low != 0) ? 63 - __builtin_clzl(low) : -1;
+}
+
+
+/**
+ * Returns the remainder of two bit polynomials
+ * @param a a bit polynomial
+ * @param b a non zero bit polynomial
+ * @return a mod b
+ */
+static Element polyMod(Element a, const Element &b)
+{
+	const int db = degreeOf(b);
+	for(int da = degreeOf(a); da >= db; da = degreeOf(a))
+	{
+		a ^= b << (da - db);
+	}
+	return a;
+}
+
+
+/**
+ * Portable carry-less product of two 64 bit polynomials, four bits of b at a time
+ * @param a a bit polynomial of degree < 64
+ * @param b a bit polynomial of degree < 64
+ * @return the 127 bit product
+ */
+static Element carrylessMultiplyPortable(const unsigned long &a, const unsigned long &b)
+{
+	Element table[16];
+	table[0] = 0;
+	for(int j = 1; j < 16; j++)
+	{
+		table[j] = (j & 1) ? table[j - 1] ^ (Element)a : table[j >> 1] << 1;
+	}
+	Element result = 0;
+	for(int i = 60; i >= 0; i -= 4)
+	{
+		result = (result << 4) ^ table[(b >> i) & 15];
+	}
+	return result;
+}
+
+
+#if defined(__x86_64__)
+/**
+ * Carry-less product of two 64 bit polynomials with PCLMULQDQ
+ * @param a a bit polynomial of degree < 64
+ * @param b a bit polynomial of degree < 64
+ * @return the 127 bit product
+ */
+__attribute__((target("pclmul")))
+static Element carrylessMultiplyHardware(const unsigned long &a, const unsigned long &b)
+{
+	__m128i product = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long)a), _mm_cvtsi64_si128((long)b), 0);
+	unsigned long words[2];
+	_mm_storeu_si128((__m128i*)words, product);
+	return ((Element)words[1] << 64) | words[0];
+}
+#endif
+
+
+/**
+ * Carry-less product of two 64 bit polynomials, with the fastest available method
+ * @param a a bit polynomial of degree < 64
+ * @param b a bit polynomial of degree < 64
+ * @return the 127 bit product
+ */
+static inline Element carrylessMultiply(const unsigned long &a, const unsigned long &b)
+{
+#if defined(__x86_64__)
+	if(GFBinary::hasCarrylessMultiply())
+	{
+		return carrylessMultiplyHardware(a, b);
+	}
+#endif
+	return carrylessMultiplyPortable(a, b);
+}
+
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Constructor - picks the irreducible polynomial of the field
+ * @param l the degree of the field, in [2, 128]
+ */
+GFBinary::GFBinary(const int &l):_l(l), _modulus(0), _termCount(0)
+{
+	assert(l >= 2 && l <= MAX_DEGREE);
+	// trinomials x^l + x^k + 1
+	for(int k = 1; k < l; k++)
+	{
+		Element candidate = ((Element)1 << k) | 1;
+		if(isIrreducible(candidate, l))
+		{
+			_modulus = candidate;
+			_terms[0] = 0;
+			_terms[1] = k;
+			_termCount = 2;
+			return;
+		}
+	}
+	// pentanomials x^l + x^a + x^b + x^c + 1
+	for(int a = 3; a < l; a++)
+	{
+		for(int b = 2; b < a; b++)
+		{
+			for(int c = 1; c < b; c++)
+			{
+				Element candidate = ((Element)1 << a) | ((Element)1 << b) | ((Element)1 << c) | 1;
+				if(isIrreducible(candidate, l))
+				{
+					_modulus = candidate;
+					_terms[0] = 0;
+					_terms[1] = c;
+					_terms[2] = b;
+					_terms[3] = a;
+					_termCount = 4;
+					return;
+				}
+			}
+		}
+	}
+	assert(false && "no irreducible trinomial or pentanomial");
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Returns the l value of this field
+ * @return l value
+ */
+const int& GFBinary::getDegree() const
+{
+	return _l;
+}
+
+
+/**
+ * Returns the irreducible polynomial of this field without its leading term x^l
+ * @return the bit vector of the lower terms
+ */
+const Element& GFBinary::getModulus() const
+{
+	return _modulus;
+}
+
+
+/**
+ * Adds (and subtracts) two elements
+ * @param a an element
+ * @param b an element
+ * @return a + b
+ */
+Element GFBinary::add(const Element &a, const Element &b)
+{
+	return a ^ b;
+}
+
+
+/**
+ * Multiplies two elements
+ * @param a an element
+ * @param b an element
+ * @return a * b
+ */
+Element GFBinary::multiply(const Element &a, const Element &b) const
+{
+	return _multiplyMod(a, b, _l, _terms, _termCount);
+}
+
+
+/**
+ * Raises an element to a power by square and multiply
+ * @param a an element
+ * @param exponent a non negative exponent
+ * @return a^exponent
+ */
+Element GFBinary::power(const Element &a, unsigned long exponent) const
+{
+	Element result = 1, base = a;
+	while(exponent > 0)
+	{
+		if(exponent & 1)
+		{
+			result = multiply(result, base);
+		}
+		base = multiply(base, base);
+		exponent >>= 1;
+	}
+	return result;
+}
+
+
+/**
+ * Returns the multiplicative inverse of an element as a^(2^l - 2)
+ * @param a a non zero element
+ * @return a^-1
+ */
+Element GFBinary::inverse(const Element &a) const
+{
+	assert(a != 0);
+	// 2^l - 2 = 2 + 4 + ... + 2^(l - 1)
+	Element result = 1, square = a;
+	for(int i = 1; i < _l; i++)
+	{
+		square = multiply(square, square);
+		result = multiply(result, square);
+	}
+	return result;
+}
+
+
+/**
+ * Check if the CPU has the carry-less multiplication instruction
+ * @return true if PCLMULQDQ is used
+ */
+bool GFBinary::hasCarrylessMultiply()
+{
+#if defined(__x86_64__)
+	static const bool available = __builtin_cpu_supports("pclmul");
+	return available;
+#else
+	return false;
+#endif
+}
+
+
+/**
+ * Check if the polynomial x^l + lowTerms is irreducible over GF(2), with Rabin's test
+ * @param lowTerms bit vector of the terms below x^l
+ * @param l degree of the polynomial, in [2, 128]
+ * @return true if the polynomial is irreducible
+ */
+bool GFBinary::isIrreducible(const Element &lowTerms, const int &l)
+{
+	if((lowTerms & 1) == 0)
+	{
+		return false;
+	}
+	int terms[MAX_DEGREE];
+	int termCount = 0;
+	for(int i = 0; i < l; i++)
+	{
+		if((lowTerms >> i) & 1)
+		{
+			terms[termCount++] = i;
+		}
+	}
+
+	// f is irreducible iff x^(2^l) = x mod f and gcd(x^(2^(l/q)) - x, f) = 1 for primes q | l
+	bool checkAt[MAX_DEGREE + 1] = {};
+	int rest = l;
+	for(int q = 2; q <= rest; q++)
+	{
+		if(rest % q == 0)
+		{
+			checkAt[l / q] = true;
+			while(rest % q == 0)
+			{
+				rest /= q;
+			}
+		}
+	}
+
+	Element h = 2;
+	for(int k = 1; k <= l; k++)
+	{
+		h = _multiplyMod(h, h, l, terms, termCount);
+		if(k < l && checkAt[k])
+		{
+			Element g = h ^ 2;
+			if(g == 0)
+			{
+				return false;
+			}
+			// f mod g = (x^l mod g) + (lowTerms mod g); the rest of Euclid fits in 128 bits
+			const int dg = degreeOf(g);
+			Element power = 1;
+			for(int i = 0; i < l; i++)
+			{
+				power <<= 1;
+				if(degreeOf(power) == dg)
+				{
+					power ^= g;
+				}
+			}
+			Element a = g, b = power ^ polyMod(lowTerms, g);
+			while(b != 0)
+			{
+				Element r = polyMod(a, b);
+				a = b;
+				b = r;
+			}
+			if(a != 1)
+			{
+				return false;
+			}
+		}
+	}
+	return h == 2;
+}
+
+
+/**
+ * Multiplies two elements modulo x^l + the given sparse terms
+ * @param a an element
+ * @param b an element
+ * @param l degree of the modulus
+ * @param terms powers below l of the modulus
+ * @param termCount number of entries of terms
+ * @return a * b mod the modulus
+ */
+Element GFBinary::_multiplyMod(const Element &a, const Element &b, const int &l, const int *terms,
+							   const int &termCount)
+{
+	const unsigned long a0 = (unsigned long)a, a1 = (unsigned long)(a >> 64);
+	const unsigned long b0 = (unsigned long)b, b1 = (unsigned long)(b >> 64);
+
+	// 256 bit product high:low
+	Element low = carrylessMultiply(a0, b0), high = 0;
+	if(a1 != 0 || b1 != 0)
+	{
+		const Element middle = carrylessMultiply(a0, b1) ^ carrylessMultiply(a1, b0);
+		high = carrylessMultiply(a1, b1) ^ (middle >> 64);
+		low ^= middle << 64;
+	}
+
+	// fold the part above x^l back with x^l = sum of the terms; each pass lowers the degree
+	const Element mask = (l == 128) ? ~(Element)0 : (((Element)1 << l) - 1);
+	while(true)
+	{
+		// the product has degree <= 2l - 2, so the part above x^l fits in 128 bits
+		const Element above = (l == 128) ? high : ((high << (128 - l)) | (low >> l));
+		if(above == 0)
+		{
+			return low & mask;
+		}
+		low &= mask;
+		high = 0;
+		for(int i = 0; i < termCount; i++)
+		{
+			const int t = terms[i];
+			low ^= above << t;
+			if(t != 0)
+			{
+				high ^= above >> (128 - t);
+			}
+		}
+	}
+}
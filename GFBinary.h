@@ -0,0 +1,114 @@
+#ifndef EX1_GFBINARY_H
+#define EX1_GFBINARY_H
+
+/**
+ * This class implements the arithmetic of the binary field GF(2**l), 2 <= l <= 128.
+ * An element is a polynomial over GF(2) packed as a bit vector (bit i is the coefficient of x^i).
+ * Addition and subtraction are XOR. Multiplication is a carry-less product - PCLMULQDQ when the
+ * CPU has it, a portable 4 bit window otherwise - folded back modulo a sparse irreducible
+ * polynomial (the first trinomial, otherwise the first pentanomial).
+ * GField uses it for every GF(2**l) with l > 1; fields with l > 62 do not fit a GFNumber and are
+ * used through this class directly.
+ */
+class GFBinary
+{
+
+public:
+
+	typedef unsigned __int128 Element;  // an element of the field
+
+	static const int MAX_DEGREE = 128;  // largest supported l
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor - picks the irreducible polynomial of the field
+	 * @param l the degree of the field, in [2, 128]
+	 */
+	explicit GFBinary(const int &l);
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Returns the l value of this field
+	 * @return l value
+	 */
+	const int& getDegree() const;
+
+	/**
+	 * Returns the irreducible polynomial of this field without its leading term x^l
+	 * @return the bit vector of the lower terms
+	 */
+	const Element& getModulus() const;
+
+	/**
+	 * Adds (and subtracts) two elements
+	 * @param a an element
+	 * @param b an element
+	 * @return a + b
+	 */
+	static Element add(const Element &a, const Element &b);
+
+	/**
+	 * Multiplies two elements
+	 * @param a an element
+	 * @param b an element
+	 * @return a * b
+	 */
+	Element multiply(const Element &a, const Element &b) const;
+
+	/**
+	 * Raises an element to a power by square and multiply
+	 * @param a an element
+	 * @param exponent a non negative exponent
+	 * @return a^exponent
+	 */
+	Element power(const Element &a, unsigned long exponent) const;
+
+	/**
+	 * Returns the multiplicative inverse of an element as a^(2^l - 2)
+	 * @param a a non zero element
+	 * @return a^-1
+	 */
+	Element inverse(const Element &a) const;
+
+	/**
+	 * Check if the CPU has the carry-less multiplication instruction
+	 * @return true if PCLMULQDQ is used
+	 */
+	static bool hasCarrylessMultiply();
+
+	/**
+	 * Check if the polynomial x^l + lowTerms is irreducible over GF(2), with Rabin's test
+	 * @param lowTerms bit vector of the terms below x^l
+	 * @param l degree of the polynomial, in [2, 128]
+	 * @return true if the polynomial is irreducible
+	 */
+	static bool isIrreducible(const Element &lowTerms, const int &l);
+
+
+private:
+
+	int _l;                 // degree of the field
+
+	Element _modulus;       // terms of the irreducible polynomial below x^l
+
+	int _terms[4];          // powers below l where the modulus is non zero
+
+	int _termCount;         // number of entries of _terms
+
+	/**
+	 * Multiplies two elements modulo x^l + the given sparse terms
+	 * @param a an element
+	 * @param b an element
+	 * @param l degree of the modulus
+	 * @param terms powers below l of the modulus
+	 * @param termCount number of entries of terms
+	 * @return a * b mod the modulus
+	 */
+	static Element _multiplyMod(const Element &a, const Element &b, const int &l, const int *terms,
+								const int &termCount);
+};
+
+
+#endif //EX1_GFBINARY_H
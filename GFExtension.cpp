@@ -0,0 +1,482 @@
+#include "GFExtension.h"
+#include "GField.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+// candidate coefficients of sparse moduli are searched up to this value
+static const long CANDIDATE_COEFFICIENT_LIMIT = 16;
+
+
+/**
+ * Returns (a * b) mod p, in 64 bits when the product fits
+ * @param a a number in [0, p)
+ * @param b a number in [0, p)
+ * @param p the modulus
+ * @return (a * b) mod p
+ */
+static long mulModP(const long &a, const long &b, const long &p)
+{
+	if(p <= (1L << 32))
+	{
+		return (long)((unsigned long)a * (unsigned long)b % (unsigned long)p);
+	}
+	return GField::mulMod(a, b, p);
+}
+
+
+/**
+ * Multiplies two polynomials of degree < l over GF(p) modulo a monic polynomial of degree l
+ * @param a coefficients of the first polynomial
+ * @param b coefficients of the second polynomial
+ * @param out receives the l coefficients of the product; may alias a or b
+ * @param f coefficients of the monic modulus, f[l] = 1
+ * @param terms powers below l where f is non zero
+ * @param termCount number of entries of terms
+ * @param l degree of the modulus
+ * @param p a prime
+ */
+static void polyMulMod(const long *a, const long *b, long *out, const long *f, const int *terms,
+					   const int &termCount, const int &l, const long &p)
+{
+	unsigned __int128 accumulators[2 * GFExtension::MAX_DEGREE] = {};
+	for(int i = 0; i < l; i++)
+	{
+		if(a[i] == 0)
+		{
+			continue;
+		}
+		for(int j = 0; j < l; j++)
+		{
+			accumulators[i + j] += (unsigned __int128)a[i] * (unsigned long)b[j];
+		}
+	}
+
+	// l * p^2 < 2^70 since p^l < 2^63, so the sums never overflow
+	long product[2 * GFExtension::MAX_DEGREE];
+	for(int k = 0; k < 2 * l - 1; k++)
+	{
+		product[k] = ((accumulators[k] >> 64) == 0) ?
+					 (long)((unsigned long)accumulators[k] % (unsigned long)p) :
+					 (long)(accumulators[k] % (unsigned long)p);
+	}
+
+	// x^k = -x^(k - l) * (f - x^l), visiting only the non zero terms of f
+	for(int k = 2 * l - 2; k >= l; k--)
+	{
+		const long t = product[k];
+		if(t == 0)
+		{
+			continue;
+		}
+		for(int i = 0; i < termCount; i++)
+		{
+			const int index = k - l + terms[i];
+			long value = product[index] - mulModP(t, f[terms[i]], p);
+			product[index] = (value < 0) ? value + p : value;
+		}
+	}
+	memcpy(out, product, sizeof(long) * l);
+}
+
+
+/**
+ * Collects the powers below l where a monic polynomial is non zero
+ * @param f coefficients of the polynomial
+ * @param l degree of the polynomial
+ * @param terms receives the powers
+ * @return number of powers
+ */
+static int collectTerms(const long *f, const int &l, int *terms)
+{
+	int count = 0;
+	for(int i = 0; i < l; i++)
+	{
+		if(f[i] != 0)
+		{
+			terms[count++] = i;
+		}
+	}
+	return count;
+}
+
+
+/**
+ * Returns the degree of a polynomial
+ * @param a coefficients
+ * @param size number of coefficients
+ * @return the degree, or -1 for the zero polynomial
+ */
+static int polyDegree(const long *a, const int &size)
+{
+	int degree = size - 1;
+	while(degree >= 0 && a[degree] == 0)
+	{
+		degree--;
+	}
+	return degree;
+}
+
+
+/**
+ * Check if two polynomials over GF(p) are coprime, with Euclid's algorithm
+ * @param g coefficients of a polynomial of degree < l
+ * @param f coefficients of a polynomial of degree l
+ * @param l degree of f
+ * @param p a prime
+ * @return true if gcd(f, g) is a non zero constant
+ */
+static bool polyCoprime(const long *g, const long *f, const int &l, const long &p)
+{
+	long u[GFExtension::MAX_DEGREE + 1], v[GFExtension::MAX_DEGREE + 1];
+	memcpy(u, f, sizeof(long) * (l + 1));
+	memset(v, 0, sizeof(long) * (l + 1));
+	memcpy(v, g, sizeof(long) * l);
+
+	int du = polyDegree(u, l + 1), dv = polyDegree(v, l + 1);
+	while(dv >= 0)
+	{
+		// u = u mod v
+		const long leadInverse = GField::powMod(v[dv], p - 2, p);
+		for(int k = du; k >= dv; k--)
+		{
+			const long t = mulModP(u[k], leadInverse, p);
+			if(t == 0)
+			{
+				continue;
+			}
+			for(int i = 0; i <= dv; i++)
+			{
+				long value = u[k - dv + i] - mulModP(t, v[i], p);
+				u[k - dv + i] = (value < 0) ? value + p : value;
+			}
+		}
+		du = polyDegree(u, dv);
+		std::swap(u, v);
+		std::swap(du, dv);
+	}
+	return du == 0;
+}
+
+
+/**
+ * Raises a polynomial to the power p modulo a monic polynomial of degree l
+ * @param h coefficients of a polynomial of degree < l; replaced by h^p mod f
+ * @param f coefficients of the modulus
+ * @param terms powers below l where f is non zero
+ * @param termCount number of entries of terms
+ * @param l degree of the modulus
+ * @param p a prime, also the exponent
+ */
+static void polyPowerP(long *h, const long *f, const int *terms, const int &termCount,
+					   const int &l, const long &p)
+{
+	long result[GFExtension::MAX_DEGREE] = {1}, base[GFExtension::MAX_DEGREE];
+	memcpy(base, h, sizeof(long) * l);
+	for(long e = p; e > 0; e >>= 1)
+	{
+		if(e & 1)
+		{
+			polyMulMod(result, base, result, f, terms, termCount, l, p);
+		}
+		if(e > 1)
+		{
+			polyMulMod(base, base, base, f, terms, termCount, l, p);
+		}
+	}
+	memcpy(h, result, sizeof(long) * l);
+}
+
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Constructor - picks the irreducible polynomial of the field
+ * @param p an odd prime
+ * @param l the degree of the extension, 1 < l and p^l < 2^63
+ */
+GFExtension::GFExtension(const long &p, const long &l):_p(p), _l(l), _termCount(0)
+{
+	assert(p != 2 && l > 1 && l <= MAX_DEGREE);  // GF(2**l) is GFBinary's
+	_findModulus();
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Returns the p value of this field
+ * @return p value
+ */
+const long& GFExtension::getChar() const
+{
+	return _p;
+}
+
+
+/**
+ * Returns the l value of this field
+ * @return l value
+ */
+const long& GFExtension::getDegree() const
+{
+	return _l;
+}
+
+
+/**
+ * Returns a coefficient of the irreducible polynomial of this field
+ * @param i a power in [0, l]
+ * @return the coefficient of x^i
+ */
+const long& GFExtension::getModulusCoefficient(const int &i) const
+{
+	assert(i >= 0 && i <= _l);
+	return _modulus[i];
+}
+
+
+/**
+ * Returns the number of non zero terms of the irreducible polynomial of this field
+ * @return number of terms, including x^l
+ */
+int GFExtension::getModulusWeight() const
+{
+	return _termCount + 1;
+}
+
+
+/**
+ * Adds two elements coefficient by coefficient
+ * @param a an element
+ * @param b an element
+ * @return a + b
+ */
+long GFExtension::add(const long &a, const long &b) const
+{
+	long x = a, y = b, result = 0, place = 1;
+	for(long i = 0; i < _l; i++)
+	{
+		long digit = x % _p + y % _p;
+		if(digit >= _p)
+		{
+			digit -= _p;
+		}
+		result += digit * place;
+		x /= _p;
+		y /= _p;
+		if(i + 1 < _l)
+		{
+			place *= _p;
+		}
+	}
+	return result;
+}
+
+
+/**
+ * Subtracts two elements coefficient by coefficient
+ * @param a an element
+ * @param b an element
+ * @return a - b
+ */
+long GFExtension::subtract(const long &a, const long &b) const
+{
+	long x = a, y = b, result = 0, place = 1;
+	for(long i = 0; i < _l; i++)
+	{
+		long digit = x % _p - y % _p;
+		if(digit < 0)
+		{
+			digit += _p;
+		}
+		result += digit * place;
+		x /= _p;
+		y /= _p;
+		if(i + 1 < _l)
+		{
+			place *= _p;
+		}
+	}
+	return result;
+}
+
+
+/**
+ * Multiplies two elements as polynomials modulo the irreducible polynomial
+ * @param a an element
+ * @param b an element
+ * @return a * b
+ */
+long GFExtension::multiply(const long &a, const long &b) const
+{
+	long x[MAX_DEGREE], y[MAX_DEGREE];
+	_decode(a, x);
+	_decode(b, y);
+	polyMulMod(x, y, x, _modulus, _terms, _termCount, (int)_l, _p);
+	return _encode(x);
+}
+
+
+/**
+ * Check if a monic polynomial is irreducible over GF(p), with Rabin's test
+ * @param f coefficients of the polynomial, f[l] = 1
+ * @param l degree of the polynomial, at least 1
+ * @param p a prime
+ * @return true if the polynomial is irreducible
+ */
+bool GFExtension::isIrreducible(const long *f, const int &l, const long &p)
+{
+	if(l == 1)
+	{
+		return true;
+	}
+	if(f[0] == 0)
+	{
+		return false;
+	}
+	int terms[MAX_DEGREE + 1];
+	const int termCount = collectTerms(f, l, terms);
+
+	// f is irreducible iff x^(p^l) = x mod f and gcd(x^(p^(l/q)) - x, f) = 1 for primes q | l
+	bool checkAt[MAX_DEGREE + 1] = {};
+	int rest = l;
+	for(int q = 2; q <= rest; q++)
+	{
+		if(rest % q == 0)
+		{
+			checkAt[l / q] = true;
+			while(rest % q == 0)
+			{
+				rest /= q;
+			}
+		}
+	}
+
+	long h[MAX_DEGREE] = {0, 1};
+	for(int k = 1; k <= l; k++)
+	{
+		polyPowerP(h, f, terms, termCount, l, p);
+		if(k < l && checkAt[k])
+		{
+			long g[MAX_DEGREE];
+			memcpy(g, h, sizeof(long) * l);
+			g[1] = (g[1] == 0) ? p - 1 : g[1] - 1;
+			if(!polyCoprime(g, f, l, p))
+			{
+				return false;
+			}
+		}
+	}
+	for(int i = 0; i < l; i++)
+	{
+		if(h[i] != ((i == 1) ? 1 : 0))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Splits an element into its l coefficients
+ * @param n an element
+ * @param digits receives the coefficients
+ */
+void GFExtension::_decode(long n, long *digits) const
+{
+	for(long i = 0; i < _l; i++)
+	{
+		digits[i] = n % _p;
+		n /= _p;
+	}
+}
+
+
+/**
+ * Packs l coefficients into an element
+ * @param digits coefficients in [0, p)
+ * @return the element
+ */
+long GFExtension::_encode(const long *digits) const
+{
+	long n = 0;
+	for(long i = _l - 1; i >= 0; i--)
+	{
+		n = n * _p + digits[i];
+	}
+	return n;
+}
+
+
+/**
+ * Tries candidates of increasing weight until one is irreducible, and stores it
+ */
+void GFExtension::_findModulus()
+{
+	const int l = (int)_l;
+	const long limit = std::min(_p - 1, CANDIDATE_COEFFICIENT_LIMIT);
+	long f[MAX_DEGREE + 1] = {};
+	f[l] = 1;
+
+	// binomials x^l + b
+	for(long b = 1; b <= limit; b++)
+	{
+		f[0] = b;
+		if(_tryModulus(f))
+		{
+			return;
+		}
+	}
+	// trinomials x^l + a x^k + b
+	for(int k = 1; k < l; k++)
+	{
+		for(long a = 1; a <= limit; a++)
+		{
+			for(long b = 1; b <= limit; b++)
+			{
+				f[k] = a;
+				f[0] = b;
+				if(_tryModulus(f))
+				{
+					return;
+				}
+			}
+		}
+		f[k] = 0;
+	}
+	// dense candidates, in increasing order of their packed coefficients
+	for(long code = 1; ; code++)
+	{
+		long rest = code;
+		for(int i = 0; i < l; i++)
+		{
+			f[i] = rest % _p;
+			rest /= _p;
+		}
+		if(f[0] != 0 && _tryModulus(f))
+		{
+			return;
+		}
+	}
+}
+
+
+/**
+ * Check a candidate and keep it if it is irreducible
+ * @param f coefficients of a monic candidate of degree l
+ * @return true if the candidate was kept
+ */
+bool GFExtension::_tryModulus(const long *f)
+{
+	if(!isIrreducible(f, (int)_l, _p))
+	{
+		return false;
+	}
+	memcpy(_modulus, f, sizeof(long) * (_l + 1));
+	_termCount = collectTerms(_modulus, (int)_l, _terms);
+	return true;
+}
@@ -0,0 +1,129 @@
+#ifndef EX1_GFEXTENSION_H
+#define EX1_GFEXTENSION_H
+
+/**
+ * This class implements the arithmetic of the extension field GF(p**l), l > 1.
+ * An element is a polynomial of degree < l over GF(p), packed into a long as the base p number
+ * whose digits are its coefficients (the constant term is the least significant digit). Products
+ * are reduced modulo a monic irreducible polynomial of degree l, chosen with as few terms as
+ * possible (binomial, then trinomial), and the reduction only visits its non zero terms.
+ * GF(2**l) is implemented by GFBinary instead.
+ */
+class GFExtension
+{
+
+public:
+
+	static const int MAX_DEGREE = 63;  // p^l < 2^63 bounds the degree
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor - picks the irreducible polynomial of the field
+	 * @param p an odd prime
+	 * @param l the degree of the extension, 1 < l and p^l < 2^63
+	 */
+	GFExtension(const long &p, const long &l);
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Returns the p value of this field
+	 * @return p value
+	 */
+	const long& getChar() const;
+
+	/**
+	 * Returns the l value of this field
+	 * @return l value
+	 */
+	const long& getDegree() const;
+
+	/**
+	 * Returns a coefficient of the irreducible polynomial of this field
+	 * @param i a power in [0, l]
+	 * @return the coefficient of x^i
+	 */
+	const long& getModulusCoefficient(const int &i) const;
+
+	/**
+	 * Returns the number of non zero terms of the irreducible polynomial of this field
+	 * @return number of terms, including x^l
+	 */
+	int getModulusWeight() const;
+
+	/**
+	 * Adds two elements coefficient by coefficient
+	 * @param a an element
+	 * @param b an element
+	 * @return a + b
+	 */
+	long add(const long &a, const long &b) const;
+
+	/**
+	 * Subtracts two elements coefficient by coefficient
+	 * @param a an element
+	 * @param b an element
+	 * @return a - b
+	 */
+	long subtract(const long &a, const long &b) const;
+
+	/**
+	 * Multiplies two elements as polynomials modulo the irreducible polynomial
+	 * @param a an element
+	 * @param b an element
+	 * @return a * b
+	 */
+	long multiply(const long &a, const long &b) const;
+
+	/**
+	 * Check if a monic polynomial is irreducible over GF(p), with Rabin's test
+	 * @param f coefficients of the polynomial, f[l] = 1
+	 * @param l degree of the polynomial, at least 1
+	 * @param p a prime
+	 * @return true if the polynomial is irreducible
+	 */
+	static bool isIrreducible(const long *f, const int &l, const long &p);
+
+
+private:
+
+	long _p;                          // char of the field
+
+	long _l;                          // degree of the field
+
+	long _modulus[MAX_DEGREE + 1];    // coefficients of the monic irreducible polynomial
+
+	int _terms[MAX_DEGREE + 1];       // powers below l with a non zero modulus coefficient
+
+	int _termCount;                   // number of entries of _terms
+
+	/**
+	 * Splits an element into its l coefficients
+	 * @param n an element
+	 * @param digits receives the coefficients
+	 */
+	void _decode(long n, long *digits) const;
+
+	/**
+	 * Packs l coefficients into an element
+	 * @param digits coefficients in [0, p)
+	 * @return the element
+	 */
+	long _encode(const long *digits) const;
+
+	/**
+	 * Tries candidates of increasing weight until one is irreducible, and stores it
+	 */
+	void _findModulus();
+
+	/**
+	 * Check a candidate and keep it if it is irreducible
+	 * @param f coefficients of a monic candidate of degree l
+	 * @return true if the candidate was kept
+	 */
+	bool _tryModulus(const long *f);
+};
+
+
+#endif //EX1_GFEXTENSION_H
@@ -0,0 +1,273 @@
+#include "GFFormatter.h"
+#include "GFNumber.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+const size_t GFFormatter::BUFFER_SIZE;
+const int GFFormatter::MAX_FACTORS_LENGTH;
+
+// longest decimal text of a long, with its sign
+static const int MAX_DIGITS = 20;
+
+
+/**
+ * Writes a number in decimal
+ * @param buffer receives the text, at least MAX_DIGITS bytes
+ * @param value a number
+ * @return the byte after the text
+ */
+static inline char* formatValue(char *buffer, const long &value)
+{
+	return std::to_chars(buffer, buffer + MAX_DIGITS, value).ptr;
+}
+
+
+////////////////////////////////////  Constructors & Destructor  //////////////////////////////////
+
+/**
+ * Default constructor - a formatter which collects its text in memory
+ */
+GFFormatter::GFFormatter():_out(nullptr), _buffer(BUFFER_SIZE), _size(0), _compact(false)
+{
+
+}
+
+
+/**
+ * Constructor - a formatter which writes to a stream in blocks
+ * @param out the stream
+ * @param capacity number of bytes held before they are written
+ */
+GFFormatter::GFFormatter(std::ostream &out, const size_t &capacity):_out(&out),
+	_buffer(std::max(capacity, (size_t)MAX_FACTORS_LENGTH)), _size(0), _compact(false)
+{
+
+}
+
+
+/**
+ * Destructor - writes what is left to the stream
+ */
+GFFormatter::~GFFormatter()
+{
+	flush();
+}
+
+
+////////////////////////////////////   Class Methods    ///////////////////////////////////////////
+
+/**
+ * Appends a number in decimal
+ * @param value a number
+ * @return this formatter
+ */
+GFFormatter& GFFormatter::append(const long &value)
+{
+	_reserve(MAX_DIGITS);
+	_size = formatValue(_buffer.data() + _size, value) - _buffer.data();
+	return *this;
+}
+
+
+/**
+ * Appends a character
+ * @param c a character
+ * @return this formatter
+ */
+GFFormatter& GFFormatter::append(const char &c)
+{
+	_reserve(1);
+	_buffer[_size++] = c;
+	return *this;
+}
+
+
+/**
+ * Appends a text
+ * @param text a null terminated text
+ * @return this formatter
+ */
+GFFormatter& GFFormatter::append(const char *text)
+{
+	const size_t length = strlen(text);
+	_reserve(length);
+	if(length > _buffer.size() - _size)
+	{
+		// longer than the whole buffer of a stream formatter: bypass it
+		_out->write(text, length);
+		return *this;
+	}
+	memcpy(_buffer.data() + _size, text, length);
+	_size += length;
+	return *this;
+}
+
+
+/**
+ * Appends a number of a field as operator<< prints it, n GF(p**l)
+ * @param number a number
+ * @return this formatter
+ */
+GFFormatter& GFFormatter::append(const GFNumber &number)
+{
+	_reserve(MAX_NUMBER_LENGTH);
+	_size = formatNumber(_buffer.data() + _size, number) - _buffer.data();
+	return *this;
+}
+
+
+/**
+ * Appends the factorization of a number as one line: n=p1*p2*..., or n=p1^e1*p2^e2*... if
+ * compact, or n=n*1 if n has less than two prime factors
+ * @param n a number
+ * @param factors the prime factors of n
+ */
+void GFFormatter::appendFactors(const long &n, const FactorList &factors)
+{
+	_reserve(MAX_FACTORS_LENGTH);
+	_size = formatFactors(_buffer.data() + _size, n, factors, _compact) - _buffer.data();
+}
+
+
+/**
+ * Sets whether repeated prime factors are printed once with their exponent
+ * @param compact true for the p^e notation
+ */
+void GFFormatter::setCompact(const bool &compact)
+{
+	_compact = compact;
+}
+
+
+/**
+ * Check if repeated prime factors are printed once with their exponent
+ * @return true for the p^e notation
+ */
+bool GFFormatter::isCompact() const
+{
+	return _compact;
+}
+
+
+/**
+ * Writes the held text to the stream, without flushing the stream; does nothing when the
+ * text is collected in memory
+ */
+void GFFormatter::flush()
+{
+	if(_out != nullptr && _size > 0)
+	{
+		_out->write(_buffer.data(), _size);
+		_size = 0;
+	}
+}
+
+
+/**
+ * Returns the held text
+ * @return the first byte of the text, which is not null terminated
+ */
+const char* GFFormatter::data() const
+{
+	return _buffer.data();
+}
+
+
+/**
+ * Returns the length of the held text
+ * @return number of bytes
+ */
+size_t GFFormatter::size() const
+{
+	return _size;
+}
+
+
+/**
+ * Drops the held text
+ */
+void GFFormatter::clear()
+{
+	_size = 0;
+}
+
+
+/**
+ * Formats a number of a field as operator<< prints it, n GF(p**l)
+ * @param buffer receives the text, at least MAX_NUMBER_LENGTH bytes
+ * @param number a number
+ * @return the byte after the text
+ */
+char* GFFormatter::formatNumber(char *buffer, const GFNumber &number)
+{
+	char *position = formatValue(buffer, number.getNumber());
+	memcpy(position, " GF(", 4);
+	position = formatValue(position + 4, number.getField().getChar());
+	memcpy(position, "**", 2);
+	position = formatValue(position + 2, number.getField().getDegree());
+	*position++ = ')';
+	return position;
+}
+
+
+/**
+ * Formats the factorization of a number as one line, as appendFactors does
+ * @param buffer receives the text, at least MAX_FACTORS_LENGTH bytes
+ * @param n a number
+ * @param factors the prime factors of n
+ * @param compact true for the p^e notation
+ * @return the byte after the text
+ */
+char* GFFormatter::formatFactors(char *buffer, const long &n, const FactorList &factors, const bool &compact)
+{
+	// the primes multiply to at most 2^63: their digits, separators and n fit MAX_FACTORS_LENGTH
+	char *position = formatValue(buffer, n);
+	*position++ = '=';
+	if(factors.count() < 2)
+	{
+		position = formatValue(position, n);
+		memcpy(position, "*1\n", 3);
+		return position + 3;
+	}
+	char separator = 0;
+	for(int i = 0; i < factors.size(); i++)
+	{
+		const int repeats = compact ? 1 : factors.getExponent(i);
+		for(int j = 0; j < repeats; j++)
+		{
+			if(separator)
+			{
+				*position++ = separator;
+			}
+			position = formatValue(position, factors.getPrime(i));
+			if(compact && factors.getExponent(i) > 1)
+			{
+				*position++ = '^';
+				position = formatValue(position, factors.getExponent(i));
+			}
+			separator = '*';
+		}
+	}
+	*position++ = '\n';
+	return position;
+}
+
+
+/**
+ * Makes room for more text, writing the held text or growing the buffer
+ * @param bytes number of bytes about to be appended
+ */
+void GFFormatter::_reserve(const size_t &bytes)
+{
+	if(_size + bytes <= _buffer.size())
+	{
+		return;
+	}
+	if(_out != nullptr)
+	{
+		flush();
+		return;
+	}
+	_buffer.resize(std::max(_buffer.size() * 2, _size + bytes));
+}
@@ -0,0 +1,161 @@
+#ifndef EX1_GFFORMATTER_H
+#define EX1_GFFORMATTER_H
+
+#include "FactorList.h"
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+class GFNumber;
+
+/**
+ * This class serializes numbers and factorizations into a reusable buffer with std::to_chars.
+ * Bound to a stream, it hands the buffer to the stream in blocks, once it is full, on flush and
+ * on destruction, and never flushes the stream itself; unbound, it collects everything in
+ * memory. Factorizations are printed n=p1*p2*..., or in the compact form n=p1^e1*p2^e2*...
+ */
+class GFFormatter
+{
+
+public:
+
+	static const size_t BUFFER_SIZE = 1 << 16;  // default number of bytes held before writing
+
+	static const int MAX_NUMBER_LENGTH = 64;    // longest text of a number, "n GF(p**l)"
+
+	static const int MAX_FACTORS_LENGTH = 256;  // longest line of a factorization, "n=p1*p2*...\n"
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Default constructor - a formatter which collects its text in memory
+	 */
+	GFFormatter();
+
+	/**
+	 * Constructor - a formatter which writes to a stream in blocks
+	 * @param out the stream
+	 * @param capacity number of bytes held before they are written
+	 */
+	explicit GFFormatter(std::ostream &out, const size_t &capacity = BUFFER_SIZE);
+
+	/**
+	 * Destructor - writes what is left to the stream
+	 */
+	~GFFormatter();
+
+	GFFormatter(const GFFormatter &other) = delete;
+
+	GFFormatter& operator=(const GFFormatter &other) = delete;
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Appends a number in decimal
+	 * @param value a number
+	 * @return this formatter
+	 */
+	GFFormatter& append(const long &value);
+
+	/**
+	 * Appends a character
+	 * @param c a character
+	 * @return this formatter
+	 */
+	GFFormatter& append(const char &c);
+
+	/**
+	 * Appends a text
+	 * @param text a null terminated text
+	 * @return this formatter
+	 */
+	GFFormatter& append(const char *text);
+
+	/**
+	 * Appends a number of a field as operator<< prints it, n GF(p**l)
+	 * @param number a number
+	 * @return this formatter
+	 */
+	GFFormatter& append(const GFNumber &number);
+
+	/**
+	 * Appends the factorization of a number as one line: n=p1*p2*..., or n=p1^e1*p2^e2*... if
+	 * compact, or n=n*1 if n has less than two prime factors
+	 * @param n a number
+	 * @param factors the prime factors of n
+	 */
+	void appendFactors(const long &n, const FactorList &factors);
+
+	/**
+	 * Sets whether repeated prime factors are printed once with their exponent
+	 * @param compact true for the p^e notation
+	 */
+	void setCompact(const bool &compact);
+
+	/**
+	 * Check if repeated prime factors are printed once with their exponent
+	 * @return true for the p^e notation
+	 */
+	bool isCompact() const;
+
+	/**
+	 * Writes the held text to the stream, without flushing the stream; does nothing when the
+	 * text is collected in memory
+	 */
+	void flush();
+
+	/**
+	 * Returns the held text
+	 * @return the first byte of the text, which is not null terminated
+	 */
+	const char* data() const;
+
+	/**
+	 * Returns the length of the held text
+	 * @return number of bytes
+	 */
+	size_t size() const;
+
+	/**
+	 * Drops the held text
+	 */
+	void clear();
+
+	/**
+	 * Formats a number of a field as operator<< prints it, n GF(p**l)
+	 * @param buffer receives the text, at least MAX_NUMBER_LENGTH bytes
+	 * @param number a number
+	 * @return the byte after the text
+	 */
+	static char* formatNumber(char *buffer, const GFNumber &number);
+
+	/**
+	 * Formats the factorization of a number as one line, as appendFactors does
+	 * @param buffer receives the text, at least MAX_FACTORS_LENGTH bytes
+	 * @param n a number
+	 * @param factors the prime factors of n
+	 * @param compact true for the p^e notation
+	 * @return the byte after the text
+	 */
+	static char* formatFactors(char *buffer, const long &n, const FactorList &factors, const bool &compact);
+
+
+private:
+
+	std::ostream *_out;         // the stream written to, nullptr if the text is kept in memory
+
+	std::vector<char> _buffer;  // the held text and free space after it
+
+	size_t _size;               // length of the held text
+
+	bool _compact;              // whether the p^e notation is used
+
+	/**
+	 * Makes room for more text, writing the held text or growing the buffer
+	 * @param bytes number of bytes about to be appended
+	 */
+	void _reserve(const size_t &bytes);
+};
+
+
+#endif //EX1_GFFORMATTER_H
@@ -0,0 +1,191 @@
+#include "GFLogTable.h"
+#include "GField.h"
+#include <cassert>
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Constructor - finds a primitive element and fills the tables
+ * @param field a field with order <= MAX_ORDER
+ */
+GFLogTable::GFLogTable(const GField &field):_order(field.getOrder()), _primitive(0)
+{
+	assert(_order <= MAX_ORDER);
+	const long groupOrder = _order - 1;
+	_exp.resize(2 * groupOrder);
+	_log.assign(_order, (unsigned short)ZERO_LOG);
+
+	// walk the powers of each candidate; the first one whose cycle covers the whole group is
+	// primitive, and its walk is the exp table
+	for(long candidate = 1; candidate < _order && _primitive == 0; candidate++)
+	{
+		long power = 1;
+		long k = 0;
+		for(; k < groupOrder; k++)
+		{
+			if(k > 0 && power == 1)
+			{
+				break;
+			}
+			_exp[k] = (unsigned short)power;
+			power = field._multiplyDirect(power, candidate);
+		}
+		if(k == groupOrder && power == 1)
+		{
+			_primitive = candidate;
+		}
+	}
+	assert(_primitive != 0);
+
+	for(long k = 0; k < groupOrder; k++)
+	{
+		_exp[groupOrder + k] = _exp[k];
+		_log[_exp[k]] = (unsigned short)k;
+	}
+
+	_zech.resize(groupOrder);
+	const long one = field.reduce(1);
+	for(long n = 0; n < groupOrder; n++)
+	{
+		_zech[n] = _log[field.add(one, _exp[n])];
+	}
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Returns the memory the tables of a field of a given order take
+ * @param order order of the field
+ * @return size in bytes
+ */
+size_t GFLogTable::bytesFor(const long &order)
+{
+	// exp twice, log and zech
+	return (size_t)(4 * order - 3) * sizeof(unsigned short);
+}
+
+
+/**
+ * Returns the primitive element the logs are taken in
+ * @return the primitive element
+ */
+const long& GFLogTable::getPrimitiveElement() const
+{
+	return _primitive;
+}
+
+
+/**
+ * Returns the log of a number
+ * @param a a number in [0, order)
+ * @return k such that g^k = a, or ZERO_LOG for 0
+ */
+unsigned short GFLogTable::getLog(const long &a) const
+{
+	return _log[a];
+}
+
+
+/**
+ * Returns a power of the primitive element
+ * @param k a log in [0, order - 1), or ZERO_LOG
+ * @return g^k, or 0 for ZERO_LOG
+ */
+long GFLogTable::getExp(const unsigned short &k) const
+{
+	return (k == ZERO_LOG) ? 0 : _exp[k];
+}
+
+
+/**
+ * Returns the Zech logarithm of a log
+ * @param n a log in [0, order - 1)
+ * @return log(1 + g^n), or ZERO_LOG when 1 + g^n = 0
+ */
+unsigned short GFLogTable::getZech(const unsigned short &n) const
+{
+	return _zech[n];
+}
+
+
+/**
+ * Adds two numbers in log representation with the Zech table
+ * @param m a log, or ZERO_LOG
+ * @param n a log, or ZERO_LOG
+ * @return log(g^m + g^n), or ZERO_LOG when the sum is 0
+ */
+unsigned short GFLogTable::addLogs(const unsigned short &m, const unsigned short &n) const
+{
+	if(m == ZERO_LOG)
+	{
+		return n;
+	}
+	if(n == ZERO_LOG)
+	{
+		return m;
+	}
+	// g^m + g^n = g^m (1 + g^(n - m))
+	const long groupOrder = _order - 1;
+	long difference = (long)n - m;
+	if(difference < 0)
+	{
+		difference += groupOrder;
+	}
+	const unsigned short zech = _zech[difference];
+	if(zech == ZERO_LOG)
+	{
+		return ZERO_LOG;
+	}
+	long sum = (long)m + zech;
+	return (unsigned short)((sum >= groupOrder) ? sum - groupOrder : sum);
+}
+
+
+/**
+ * Divides two numbers
+ * @param a a number in [0, order)
+ * @param b a non zero number in [0, order)
+ * @return a / b
+ */
+long GFLogTable::divide(const long &a, const long &b) const
+{
+	assert(b != 0);
+	if(a == 0)
+	{
+		return 0;
+	}
+	return _exp[_log[a] + (_order - 1) - _log[b]];
+}
+
+
+/**
+ * Returns the multiplicative inverse of a number
+ * @param a a non zero number in [0, order)
+ * @return a^-1
+ */
+long GFLogTable::inverse(const long &a) const
+{
+	assert(a != 0);
+	return _exp[(_order - 1) - _log[a]];
+}
+
+
+/**
+ * Raises a number to a power
+ * @param a a number in [0, order)
+ * @param exponent a non negative exponent
+ * @return a^exponent
+ */
+long GFLogTable::power(const long &a, const long &exponent) const
+{
+	assert(exponent >= 0);
+	if(a == 0)
+	{
+		return (exponent == 0) ? 1 : 0;
+	}
+	const long groupOrder = _order - 1;
+	return _exp[(_log[a] * (exponent % groupOrder)) % groupOrder];
+}
@@ -0,0 +1,132 @@
+#ifndef EX1_GFLOGTABLE_H
+#define EX1_GFLOGTABLE_H
+
+#include <cstddef>
+#include <vector>
+
+class GField;
+
+/**
+ * This class holds the log, antilog (exp) and Zech logarithm tables of a small field, so that
+ * multiplication, division, inversion and exponentiation are a couple of table loads.
+ * Logs are taken in base a primitive element g: exp[k] = g^k and log[g^k] = k. The exp table is
+ * stored twice so that the sum of two logs needs no reduction. The Zech table gives
+ * zech[n] = log(1 + g^n), which adds two numbers kept in log representation.
+ * GField builds one table per field on demand, within a memory budget (see
+ * GField::setLogTableBudget), and every GFNumber of the field shares it.
+ */
+class GFLogTable
+{
+
+public:
+
+	static const long MAX_ORDER = 65536;  // logs and values must fit in 16 bits
+
+	static const unsigned short ZERO_LOG = 0xFFFF;  // log representation of 0
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor - finds a primitive element and fills the tables
+	 * @param field a field with order <= MAX_ORDER
+	 */
+	explicit GFLogTable(const GField &field);
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Returns the memory the tables of a field of a given order take
+	 * @param order order of the field
+	 * @return size in bytes
+	 */
+	static size_t bytesFor(const long &order);
+
+	/**
+	 * Returns the primitive element the logs are taken in
+	 * @return the primitive element
+	 */
+	const long& getPrimitiveElement() const;
+
+	/**
+	 * Returns the log of a number
+	 * @param a a number in [0, order)
+	 * @return k such that g^k = a, or ZERO_LOG for 0
+	 */
+	unsigned short getLog(const long &a) const;
+
+	/**
+	 * Returns a power of the primitive element
+	 * @param k a log in [0, order - 1), or ZERO_LOG
+	 * @return g^k, or 0 for ZERO_LOG
+	 */
+	long getExp(const unsigned short &k) const;
+
+	/**
+	 * Returns the Zech logarithm of a log
+	 * @param n a log in [0, order - 1)
+	 * @return log(1 + g^n), or ZERO_LOG when 1 + g^n = 0
+	 */
+	unsigned short getZech(const unsigned short &n) const;
+
+	/**
+	 * Adds two numbers in log representation with the Zech table
+	 * @param m a log, or ZERO_LOG
+	 * @param n a log, or ZERO_LOG
+	 * @return log(g^m + g^n), or ZERO_LOG when the sum is 0
+	 */
+	unsigned short addLogs(const unsigned short &m, const unsigned short &n) const;
+
+	/**
+	 * Multiplies two numbers
+	 * @param a a number in [0, order)
+	 * @param b a number in [0, order)
+	 * @return a * b
+	 */
+	long multiply(const long &a, const long &b) const
+	{
+		if(a == 0 || b == 0)
+		{
+			return 0;
+		}
+		return _exp[_log[a] + _log[b]];
+	}
+
+	/**
+	 * Divides two numbers
+	 * @param a a number in [0, order)
+	 * @param b a non zero number in [0, order)
+	 * @return a / b
+	 */
+	long divide(const long &a, const long &b) const;
+
+	/**
+	 * Returns the multiplicative inverse of a number
+	 * @param a a non zero number in [0, order)
+	 * @return a^-1
+	 */
+	long inverse(const long &a) const;
+
+	/**
+	 * Raises a number to a power
+	 * @param a a number in [0, order)
+	 * @param exponent a non negative exponent
+	 * @return a^exponent
+	 */
+	long power(const long &a, const long &exponent) const;
+
+
+private:
+
+	long _order;                        // order of the field
+
+	long _primitive;                    // the primitive element g
+
+	std::vector<unsigned short> _exp;   // g^k for k in [0, 2(order - 1))
+
+	std::vector<unsigned short> _log;   // log of every number, ZERO_LOG for 0
+
+	std::vector<unsigned short> _zech;  // log(1 + g^n) for n in [0, order - 1)
+};
+
+
+#endif //EX1_GFLOGTABLE_H
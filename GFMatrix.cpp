@@ -0,0 +1,838 @@
+#include "GFMatrix.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// alignment of the value buffers, one cache line
+static const size_t ALIGNMENT = 64;
+
+// rows, columns and inner products of one block of a product
+static const int BLOCK_ROWS = 32;
+static const int BLOCK_COLUMNS = 256;
+static const int BLOCK_INNER = 128;
+
+// smallest size multiplied with Strassen's recursion, 0 if disabled
+static int strassenThreshold = 0;
+
+
+/**
+ * Returns how many products of two reduced values a 128 bit sum can take on top of a reduced
+ * value, capped at the inner block size
+ * @param order order of a prime field
+ * @return number of products accumulated between two reductions
+ */
+static int delayLimit(const long &order)
+{
+	const unsigned __int128 square = (unsigned __int128)(order - 1) * (unsigned long)(order - 1);
+	if(square == 0)
+	{
+		return BLOCK_INNER;
+	}
+	const unsigned __int128 limit = (~(unsigned __int128)0 - (unsigned long)order) / square;
+	return (limit < (unsigned __int128)BLOCK_INNER) ? (int)limit : BLOCK_INNER;
+}
+
+
+/**
+ * Multiplies two blocks of values, c = a * b or c = c - a * b. Over prime fields the products
+ * are summed in 128 bits and reduced once per block of the inner dimension.
+ * @param field the field of the values
+ * @param a rows x inner values
+ * @param strideA distance between two rows of a
+ * @param b inner x columns values
+ * @param strideB distance between two rows of b
+ * @param c rows x columns values
+ * @param strideC distance between two rows of c
+ * @param rows number of rows of a and c
+ * @param inner number of columns of a and rows of b
+ * @param columns number of columns of b and c
+ * @param subtract true to subtract the product from c
+ */
+static void multiplyBlock(const GField &field, const long *a, const long &strideA, const long *b,
+						  const long &strideB, long *c, const long &strideC, const int &rows,
+						  const int &inner, const int &columns, const bool &subtract)
+{
+	if(field.getDegree() != 1)
+	{
+		std::vector<long> row(columns);
+		for(int i = 0; i < rows; i++)
+		{
+			std::fill(row.begin(), row.end(), 0);
+			for(int s = 0; s < inner; s++)
+			{
+				const long factor = a[i * strideA + s];
+				if(factor == 0)
+				{
+					continue;
+				}
+				const long *source = b + s * strideB;
+				for(int j = 0; j < columns; j++)
+				{
+					row[j] = field.add(row[j], field.multiply(factor, source[j]));
+				}
+			}
+			long *target = c + i * strideC;
+			for(int j = 0; j < columns; j++)
+			{
+				target[j] = subtract ? field.subtract(target[j], row[j]) : row[j];
+			}
+		}
+		return;
+	}
+
+	const unsigned long p = (unsigned long)field.getOrder();
+	const int delay = delayLimit(field.getOrder());
+	thread_local std::vector<unsigned __int128> sums;
+	sums.resize(BLOCK_ROWS * BLOCK_COLUMNS);
+	for(int i0 = 0; i0 < rows; i0 += BLOCK_ROWS)
+	{
+		const int i1 = std::min(rows, i0 + BLOCK_ROWS);
+		for(int j0 = 0; j0 < columns; j0 += BLOCK_COLUMNS)
+		{
+			const int width = std::min(columns, j0 + BLOCK_COLUMNS) - j0;
+			std::fill(sums.begin(), sums.end(), 0);
+			for(int s0 = 0; s0 < inner; s0 += delay)
+			{
+				const int s1 = std::min(inner, s0 + delay);
+				for(int i = i0; i < i1; i++)
+				{
+					unsigned __int128 *sum = sums.data() + (i - i0) * BLOCK_COLUMNS;
+					for(int s = s0; s < s1; s++)
+					{
+						const unsigned long factor = (unsigned long)a[i * strideA + s];
+						if(factor == 0)
+						{
+							continue;
+						}
+						const long *source = b + s * strideB + j0;
+						for(int j = 0; j < width; j++)
+						{
+							sum[j] += (unsigned __int128)factor * (unsigned long)source[j];
+						}
+					}
+					// one reduction per block keeps the next block from overflowing
+					for(int j = 0; j < width; j++)
+					{
+						sum[j] %= p;
+					}
+				}
+			}
+			for(int i = i0; i < i1; i++)
+			{
+				const unsigned __int128 *sum = sums.data() + (i - i0) * BLOCK_COLUMNS;
+				long *target = c + i * strideC + j0;
+				for(int j = 0; j < width; j++)
+				{
+					target[j] = subtract ? field.subtract(target[j], (long)sum[j]) : (long)sum[j];
+				}
+			}
+		}
+	}
+}
+
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Default constructor - an empty matrix over GF(2**1)
+ */
+GFMatrix::GFMatrix():_gField(), _residues(nullptr), _rows(0), _columns(0)
+{
+
+}
+
+
+/**
+ * Constructor - a matrix of zeros
+ * @param field the field of the numbers
+ * @param rows number of rows
+ * @param columns number of columns
+ */
+GFMatrix::GFMatrix(const GField &field, const int &rows, const int &columns):_gField(field),
+																			 _rows(rows),
+																			 _columns(columns)
+{
+	assert(rows >= 0 && columns >= 0);
+	_residues = _allocate((long)rows * columns);
+	memset(_residues, 0, sizeof(long) * rows * columns);
+}
+
+
+/**
+ * Copy constructor
+ * @param other another matrix
+ */
+GFMatrix::GFMatrix(const GFMatrix &other):_gField(other._gField), _rows(other._rows),
+										  _columns(other._columns)
+{
+	_residues = _allocate((long)_rows * _columns);
+	memcpy(_residues, other._residues, sizeof(long) * _rows * _columns);
+}
+
+
+/**
+ * Destructor
+ */
+GFMatrix::~GFMatrix()
+{
+	free(_residues);
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Returns an identity matrix
+ * @param field the field of the numbers
+ * @param size number of rows and columns
+ * @return the identity matrix
+ */
+GFMatrix GFMatrix::identity(const GField &field, const int &size)
+{
+	GFMatrix result(field, size, size);
+	for(int i = 0; i < size; i++)
+	{
+		result._at(i, i) = field.reduce(1);
+	}
+	return result;
+}
+
+
+/**
+ * Returns the number of rows of this matrix
+ * @return number of rows
+ */
+int GFMatrix::getRows() const
+{
+	return _rows;
+}
+
+
+/**
+ * Returns the number of columns of this matrix
+ * @return number of columns
+ */
+int GFMatrix::getColumns() const
+{
+	return _columns;
+}
+
+
+/**
+ * Function returns the field of the numbers of this matrix
+ * @return field of this matrix
+ */
+const GField& GFMatrix::getField() const
+{
+	return _gField;
+}
+
+
+/**
+ * Returns the reduced value at a position
+ * @param i a row in [0, getRows())
+ * @param j a column in [0, getColumns())
+ * @return the value at row i and column j
+ */
+const long& GFMatrix::get(const int &i, const int &j) const
+{
+	assert(i >= 0 && i < _rows && j >= 0 && j < _columns);
+	return _residues[(long)i * _columns + j];
+}
+
+
+/**
+ * Sets the value at a position
+ * @param i a row in [0, getRows())
+ * @param j a column in [0, getColumns())
+ * @param value any number, reduced into the field
+ */
+void GFMatrix::set(const int &i, const int &j, const long &value)
+{
+	_at(i, j) = _gField.reduce(value);
+}
+
+
+/**
+ * Returns the number at a position
+ * @param i a row in [0, getRows())
+ * @param j a column in [0, getColumns())
+ * @return the number at row i and column j
+ */
+GFNumber GFMatrix::getNumber(const int &i, const int &j) const
+{
+	return GFNumber(get(i, j), _gField);
+}
+
+
+/**
+ * Returns the buffer of reduced values, row after row
+ * @return pointer to the first value
+ */
+const long* GFMatrix::data() const
+{
+	return _residues;
+}
+
+
+/**
+ * Sets this matrix to the sum of two matrices of its field and dimensions
+ * @param a a matrix
+ * @param b a matrix
+ */
+void GFMatrix::add(const GFMatrix &a, const GFMatrix &b)
+{
+	assert(a._rows == _rows && b._rows == _rows && a._columns == _columns && b._columns == _columns);
+	assert(a._gField.getOrder() == _gField.getOrder() && b._gField.getOrder() == _gField.getOrder());
+	const long size = (long)_rows * _columns;
+	for(long i = 0; i < size; i++)
+	{
+		_residues[i] = _gField.add(a._residues[i], b._residues[i]);
+	}
+}
+
+
+/**
+ * Sets this matrix to the difference of two matrices of its field and dimensions
+ * @param a a matrix
+ * @param b a matrix
+ */
+void GFMatrix::subtract(const GFMatrix &a, const GFMatrix &b)
+{
+	assert(a._rows == _rows && b._rows == _rows && a._columns == _columns && b._columns == _columns);
+	assert(a._gField.getOrder() == _gField.getOrder() && b._gField.getOrder() == _gField.getOrder());
+	const long size = (long)_rows * _columns;
+	for(long i = 0; i < size; i++)
+	{
+		_residues[i] = _gField.subtract(a._residues[i], b._residues[i]);
+	}
+}
+
+
+/**
+ * Sets this matrix to the product of two matrices of its field
+ * @param a a matrix with as many columns as b has rows
+ * @param b a matrix
+ */
+void GFMatrix::multiply(const GFMatrix &a, const GFMatrix &b)
+{
+	assert(a._columns == b._rows);
+	assert(a._gField.getOrder() == b._gField.getOrder());
+	if(this == &a || this == &b)
+	{
+		GFMatrix product(a._gField, a._rows, b._columns);
+		product.multiply(a, b);
+		*this = product;
+		return;
+	}
+	if(_rows != a._rows || _columns != b._columns)
+	{
+		free(_residues);
+		_rows = a._rows;
+		_columns = b._columns;
+		_residues = _allocate((long)_rows * _columns);
+	}
+	_gField = a._gField;
+
+	const int size = a._rows;
+	if(strassenThreshold > 0 && _gField.getDegree() == 1 && size >= strassenThreshold &&
+	   size % 2 == 0 && a._columns == size && b._columns == size)
+	{
+		_strassen(a, b);
+		return;
+	}
+	ThreadPool::parallelFor(_rows, (long)a._columns * b._columns,
+		[&](const int &, const long &begin, const long &end)
+	{
+		multiplyBlock(_gField, a._residues + begin * a._columns, a._columns, b._residues,
+					  b._columns, _residues + begin * _columns, _columns, (int)(end - begin),
+					  a._columns, b._columns, false);
+	});
+}
+
+
+/**
+ * Brings this matrix to row echelon form in place
+ * @return the rank of the matrix
+ */
+int GFMatrix::echelon()
+{
+	std::vector<int> pivotColumns(_rows);
+	int swaps;
+	return _eliminate(_columns, pivotColumns.data(), &swaps);
+}
+
+
+/**
+ * Returns the rank of this matrix
+ * @return the rank
+ */
+int GFMatrix::rank() const
+{
+	GFMatrix copy(*this);
+	return copy.echelon();
+}
+
+
+/**
+ * Returns the determinant of this square matrix
+ * @return the determinant
+ */
+GFNumber GFMatrix::determinant() const
+{
+	assert(_rows == _columns);
+	GFMatrix copy(*this);
+	std::vector<int> pivotColumns(_rows);
+	int swaps;
+	if(copy._eliminate(_columns, pivotColumns.data(), &swaps) < _rows)
+	{
+		return GFNumber(0, _gField);
+	}
+	long product = _gField.reduce(1);
+	for(int i = 0; i < _rows; i++)
+	{
+		product = _gField.multiply(product, copy.get(i, i));
+	}
+	if(swaps % 2 != 0)
+	{
+		product = _gField.subtract(0, product);
+	}
+	return GFNumber(product, _gField);
+}
+
+
+/**
+ * Solves the system A x = b, where A is this matrix
+ * @param b a vector with getRows() numbers of the field
+ * @param x receives a solution with getColumns() numbers; free variables are 0
+ * @return false if the system has no solution
+ */
+bool GFMatrix::solve(const GFVector &b, GFVector &x) const
+{
+	assert(b.size() == _rows && b.getField().getOrder() == _gField.getOrder());
+	GFMatrix augmented(_gField, _rows, _columns + 1);
+	for(int i = 0; i < _rows; i++)
+	{
+		memcpy(&augmented._at(i, 0), _residues + (long)i * _columns, sizeof(long) * _columns);
+		augmented._at(i, _columns) = b.get(i);
+	}
+	std::vector<int> pivotColumns(_rows);
+	int swaps;
+	const int rank = augmented._eliminate(_columns, pivotColumns.data(), &swaps);
+	for(int i = rank; i < _rows; i++)
+	{
+		if(augmented.get(i, _columns) != 0)
+		{
+			return false;
+		}
+	}
+	GFMatrix solution;
+	augmented._backSubstitute(_columns, rank, pivotColumns.data(), solution);
+	x = GFVector(_gField, _columns);
+	for(int j = 0; j < _columns; j++)
+	{
+		x.set(j, solution.get(j, 0));
+	}
+	return true;
+}
+
+
+/**
+ * Computes the inverse of this square matrix
+ * @param result receives the inverse
+ * @return false if the matrix is singular
+ */
+bool GFMatrix::inverse(GFMatrix &result) const
+{
+	assert(_rows == _columns);
+	const int size = _rows;
+	GFMatrix augmented(_gField, size, 2 * size);
+	for(int i = 0; i < size; i++)
+	{
+		memcpy(&augmented._at(i, 0), _residues + (long)i * size, sizeof(long) * size);
+		augmented._at(i, size + i) = _gField.reduce(1);
+	}
+	std::vector<int> pivotColumns(size);
+	int swaps;
+	if(augmented._eliminate(size, pivotColumns.data(), &swaps) < size)
+	{
+		return false;
+	}
+	augmented._backSubstitute(size, size, pivotColumns.data(), result);
+	return true;
+}
+
+
+/**
+ * Sets the smallest size of square prime field matrices multiplied with Strassen's
+ * recursion; 0, the default, disables it
+ * @param size the threshold
+ */
+void GFMatrix::setStrassenThreshold(const int &size)
+{
+	assert(size >= 0);
+	strassenThreshold = size;
+}
+
+
+/**
+ * Returns the smallest size of square matrices multiplied with Strassen's recursion
+ * @return the threshold, 0 if disabled
+ */
+int GFMatrix::getStrassenThreshold()
+{
+	return strassenThreshold;
+}
+
+
+/**
+ * Returns the value at a position for writing
+ * @param i a row
+ * @param j a column
+ * @return reference to the value
+ */
+long& GFMatrix::_at(const int &i, const int &j)
+{
+	assert(i >= 0 && i < _rows && j >= 0 && j < _columns);
+	return _residues[(long)i * _columns + j];
+}
+
+
+/**
+ * Blocked LU elimination to row echelon form, looking for pivots only in the first columns
+ * @param pivotLimit number of columns in which pivots are looked for
+ * @param pivotColumns receives the pivot column of each pivot row
+ * @param swaps receives the number of row swaps
+ * @return the number of pivots
+ */
+int GFMatrix::_eliminate(const int &pivotLimit, int *pivotColumns, int *swaps)
+{
+	const long n = _columns;
+	int first = 0;
+	*swaps = 0;
+	std::vector<long> multipliers;
+	for(int c0 = 0; c0 < pivotLimit && first < _rows; c0 += PANEL)
+	{
+		// factor the panel alone: below each pivot only the panel columns are updated, and
+		// the multipliers are kept where the eliminated values were
+		const int c1 = std::min(pivotLimit, c0 + PANEL);
+		int next = first;
+		for(int c = c0; c < c1 && next < _rows; c++)
+		{
+			int found = next;
+			while(found < _rows && get(found, c) == 0)
+			{
+				found++;
+			}
+			if(found == _rows)
+			{
+				continue;
+			}
+			if(found != next)
+			{
+				std::swap_ranges(&_at(found, 0), &_at(found, 0) + n, &_at(next, 0));
+				(*swaps)++;
+			}
+			const long inverse = _gField.inverse(get(next, c));
+			for(int i = next + 1; i < _rows; i++)
+			{
+				if(get(i, c) == 0)
+				{
+					continue;
+				}
+				const long factor = _gField.multiply(get(i, c), inverse);
+				_at(i, c) = factor;
+				for(int j = c + 1; j < c1; j++)
+				{
+					_at(i, j) = _gField.subtract(get(i, j), _gField.multiply(factor, get(next, j)));
+				}
+			}
+			pivotColumns[next++] = c;
+		}
+		const int pivots = next - first;
+
+		if(pivots > 0 && c1 < n)
+		{
+			// the pivot rows right of the panel: forward substitution with the unit lower
+			// triangle of the multipliers, split by columns
+			ThreadPool::parallelFor(n - c1, (long)pivots * pivots / 2,
+				[&](const int &, const long &begin, const long &end)
+			{
+				for(int t = 1; t < pivots; t++)
+				{
+					for(int s = 0; s < t; s++)
+					{
+						const long factor = get(first + t, pivotColumns[first + s]);
+						if(factor == 0)
+						{
+							continue;
+						}
+						const long *source = &get(first + s, (int)(c1 + begin));
+						long *target = &_at(first + t, (int)(c1 + begin));
+						for(long j = 0; j < end - begin; j++)
+						{
+							target[j] = _gField.subtract(target[j], _gField.multiply(factor, source[j]));
+						}
+					}
+				}
+			});
+
+			// the rows below: one blocked product with the gathered multipliers, split by rows
+			const int below = _rows - next;
+			multipliers.assign((long)below * pivots, 0);
+			for(int i = 0; i < below; i++)
+			{
+				for(int s = 0; s < pivots; s++)
+				{
+					multipliers[(long)i * pivots + s] = get(next + i, pivotColumns[first + s]);
+				}
+			}
+			ThreadPool::parallelFor(below, (long)pivots * (n - c1),
+				[&](const int &, const long &begin, const long &end)
+			{
+				multiplyBlock(_gField, multipliers.data() + begin * pivots, pivots,
+							  &get(first, c1), n, &_at((int)(next + begin), c1), n,
+							  (int)(end - begin), pivots, (int)(n - c1), true);
+			});
+		}
+
+		// the multipliers are not part of the echelon form
+		for(int i = first; i < _rows; i++)
+		{
+			const int last = (i < next) ? i - first : pivots;
+			for(int s = 0; s < last; s++)
+			{
+				_at(i, pivotColumns[first + s]) = 0;
+			}
+		}
+		first = next;
+	}
+	return first;
+}
+
+
+/**
+ * Solves for the columns after pivotLimit of an eliminated augmented matrix
+ * @param pivotLimit number of columns of the coefficient part
+ * @param rank number of pivots
+ * @param pivotColumns pivot column of each pivot row
+ * @param result receives a pivotLimit x (getColumns() - pivotLimit) solution
+ */
+void GFMatrix::_backSubstitute(const int &pivotLimit, const int &rank, const int *pivotColumns,
+							   GFMatrix &result) const
+{
+	const int width = _columns - pivotLimit;
+	std::vector<long> inverses(rank);
+	for(int t = 0; t < rank; t++)
+	{
+		inverses[t] = _gField.inverse(get(t, pivotColumns[t]));
+	}
+
+	// the unknowns of the pivot columns, in pivot order, so that the rows after row t are
+	// contiguous and each row is one blocked product
+	std::vector<long> solved((long)rank * width);
+	ThreadPool::parallelFor(width, (long)rank * rank / 2,
+		[&](const int &, const long &begin, const long &end)
+	{
+		const int chunk = (int)(end - begin);
+		std::vector<long> coefficients(rank);
+		for(int t = rank - 1; t >= 0; t--)
+		{
+			long *target = solved.data() + (long)t * width + begin;
+			memcpy(target, &get(t, (int)(pivotLimit + begin)), sizeof(long) * chunk);
+			const int after = rank - 1 - t;
+			for(int s = 0; s < after; s++)
+			{
+				coefficients[s] = get(t, pivotColumns[t + 1 + s]);
+			}
+			multiplyBlock(_gField, coefficients.data(), after, target + width, width, target, width, 1,
+						  after, chunk, true);
+			for(int j = 0; j < chunk; j++)
+			{
+				target[j] = _gField.multiply(target[j], inverses[t]);
+			}
+		}
+	});
+
+	result = GFMatrix(_gField, pivotLimit, width);
+	for(int t = 0; t < rank; t++)
+	{
+		memcpy(&result._at(pivotColumns[t], 0), solved.data() + (long)t * width, sizeof(long) * width);
+	}
+}
+
+
+/**
+ * Multiplies two square matrices of even size with one level of Strassen's recursion
+ * @param a a matrix
+ * @param b a matrix
+ */
+void GFMatrix::_strassen(const GFMatrix &a, const GFMatrix &b)
+{
+	const int half = a._rows / 2;
+	GFMatrix quarters[8];
+	for(int q = 0; q < 8; q++)
+	{
+		const GFMatrix &source = (q < 4) ? a : b;
+		const int row = ((q % 4) / 2) * half, column = (q % 2) * half;
+		quarters[q] = GFMatrix(_gField, half, half);
+		for(int i = 0; i < half; i++)
+		{
+			memcpy(&quarters[q]._at(i, 0), &source.get(row + i, column), sizeof(long) * half);
+		}
+	}
+	const GFMatrix &a11 = quarters[0], &a12 = quarters[1], &a21 = quarters[2], &a22 = quarters[3];
+	const GFMatrix &b11 = quarters[4], &b12 = quarters[5], &b21 = quarters[6], &b22 = quarters[7];
+
+	GFMatrix left(_gField, half, half), right(_gField, half, half), m[7];
+	left.add(a11, a22);
+	right.add(b11, b22);
+	m[0].multiply(left, right);
+	left.add(a21, a22);
+	m[1].multiply(left, b11);
+	right.subtract(b12, b22);
+	m[2].multiply(a11, right);
+	right.subtract(b21, b11);
+	m[3].multiply(a22, right);
+	left.add(a11, a12);
+	m[4].multiply(left, b22);
+	left.subtract(a21, a11);
+	right.add(b11, b12);
+	m[5].multiply(left, right);
+	left.subtract(a12, a22);
+	right.add(b21, b22);
+	m[6].multiply(left, right);
+
+	// c11 = m1 + m4 - m5 + m7, c12 = m3 + m5, c21 = m2 + m4, c22 = m1 - m2 + m3 + m6
+	GFMatrix c[4] = {m[0], m[2], m[1], m[0]};
+	c[0] += m[3];
+	c[0] -= m[4];
+	c[0] += m[6];
+	c[1] += m[4];
+	c[2] += m[3];
+	c[3] -= m[1];
+	c[3] += m[2];
+	c[3] += m[5];
+	for(int q = 0; q < 4; q++)
+	{
+		const int row = (q / 2) * half, column = (q % 2) * half;
+		for(int i = 0; i < half; i++)
+		{
+			memcpy(&_at(row + i, column), &c[q].get(i, 0), sizeof(long) * half);
+		}
+	}
+}
+
+
+/**
+ * Allocates an aligned buffer for size values
+ * @param size number of values
+ * @return the buffer
+ */
+long* GFMatrix::_allocate(const long &size)
+{
+	// aligned_alloc needs a multiple of the alignment, and never returns null for a zero size
+	size_t bytes = (sizeof(long) * size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	long *buffer = (long*)aligned_alloc(ALIGNMENT, (bytes == 0) ? ALIGNMENT : bytes);
+	assert(buffer != nullptr);
+	return buffer;
+}
+
+
+
+////////////////////////////////////////   Operators    ///////////////////////////////////////
+
+/**
+ * Overload '=' operator to place one GFMatrix into another
+ * @param other The GFMatrix object to be placed in this object
+ * @return A reference to this object after the other matrix was placed into it
+ */
+GFMatrix& GFMatrix::operator=(const GFMatrix &other)
+{
+	if(this == &other)
+	{
+		return *this;
+	}
+	if((long)_rows * _columns != (long)other._rows * other._columns)
+	{
+		free(_residues);
+		_residues = _allocate((long)other._rows * other._columns);
+	}
+	_rows = other._rows;
+	_columns = other._columns;
+	_gField = other._gField;
+	memcpy(_residues, other._residues, sizeof(long) * _rows * _columns);
+	return *this;
+}
+
+
+/**
+ * Overload '+=' operator to add a matrix to this matrix
+ * @param other a matrix of the same field and dimensions
+ * @return This matrix after the addition
+ */
+GFMatrix& GFMatrix::operator+=(const GFMatrix &other)
+{
+	add(*this, other);
+	return *this;
+}
+
+
+/**
+ * Overload '-=' operator to subtract a matrix from this matrix
+ * @param other a matrix of the same field and dimensions
+ * @return This matrix after the subtraction
+ */
+GFMatrix& GFMatrix::operator-=(const GFMatrix &other)
+{
+	subtract(*this, other);
+	return *this;
+}
+
+
+/**
+ * Overload '*=' operator to multiply this matrix by another matrix from the right
+ * @param other a matrix of the same field with as many rows as this matrix has columns
+ * @return This matrix after the multiplication
+ */
+GFMatrix& GFMatrix::operator*=(const GFMatrix &other)
+{
+	multiply(*this, other);
+	return *this;
+}
+
+
+/**
+ * Overload '*' operator to multiply two matrices
+ * @param other a matrix of the same field with as many rows as this matrix has columns
+ * @return the product
+ */
+GFMatrix GFMatrix::operator*(const GFMatrix &other) const
+{
+	GFMatrix result;
+	result.multiply(*this, other);
+	return result;
+}
+
+
+/**
+ * Overload '<<' operator to print a matrix one row per line
+ * @param out A reference to the output
+ * @param matrix the matrix to be printed
+ * @return the output containing the values of the matrix
+ */
+std::ostream& operator<<(std::ostream &out, const GFMatrix &matrix)
+{
+	for(int i = 0; i < matrix._rows; i++)
+	{
+		for(int j = 0; j < matrix._columns; j++)
+		{
+			out << ((j > 0) ? " " : "") << matrix.get(i, j);
+		}
+		out << '\n';
+	}
+	return out;
+}
@@ -0,0 +1,275 @@
+#ifndef EX1_GFMATRIX_H
+#define EX1_GFMATRIX_H
+
+#include "GField.h"
+#include "GFNumber.h"
+#include "GFVector.h"
+
+/**
+ * This class represents a dense matrix of numbers of one field, stored row-major as a
+ * contiguous, 64 byte aligned buffer of reduced values with a single shared field.
+ * Products over prime fields are cache blocked and accumulate in 128 bits, reducing once per
+ * block of the inner dimension instead of once per product; square matrices above a threshold
+ * can use Strassen's recursion. Elimination is a blocked LU: each panel of columns is factored
+ * alone and the rest of the matrix is updated with one blocked product per panel.
+ * Products and panel updates are split over the ThreadPool::getThreads() threads.
+ */
+class GFMatrix
+{
+
+public:
+
+	static const int PANEL = 64;  // number of columns factored together by the elimination
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Default constructor - an empty matrix over GF(2**1)
+	 */
+	GFMatrix();
+
+	/**
+	 * Constructor - a matrix of zeros
+	 * @param field the field of the numbers
+	 * @param rows number of rows
+	 * @param columns number of columns
+	 */
+	GFMatrix(const GField &field, const int &rows, const int &columns);
+
+	/**
+	 * Copy constructor
+	 * @param other another matrix
+	 */
+	GFMatrix(const GFMatrix &other);
+
+	/**
+	 * Destructor
+	 */
+	~GFMatrix();
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Returns an identity matrix
+	 * @param field the field of the numbers
+	 * @param size number of rows and columns
+	 * @return the identity matrix
+	 */
+	static GFMatrix identity(const GField &field, const int &size);
+
+	/**
+	 * Returns the number of rows of this matrix
+	 * @return number of rows
+	 */
+	int getRows() const;
+
+	/**
+	 * Returns the number of columns of this matrix
+	 * @return number of columns
+	 */
+	int getColumns() const;
+
+	/**
+	 * Function returns the field of the numbers of this matrix
+	 * @return field of this matrix
+	 */
+	const GField& getField() const;
+
+	/**
+	 * Returns the reduced value at a position
+	 * @param i a row in [0, getRows())
+	 * @param j a column in [0, getColumns())
+	 * @return the value at row i and column j
+	 */
+	const long& get(const int &i, const int &j) const;
+
+	/**
+	 * Sets the value at a position
+	 * @param i a row in [0, getRows())
+	 * @param j a column in [0, getColumns())
+	 * @param value any number, reduced into the field
+	 */
+	void set(const int &i, const int &j, const long &value);
+
+	/**
+	 * Returns the number at a position
+	 * @param i a row in [0, getRows())
+	 * @param j a column in [0, getColumns())
+	 * @return the number at row i and column j
+	 */
+	GFNumber getNumber(const int &i, const int &j) const;
+
+	/**
+	 * Returns the buffer of reduced values, row after row
+	 * @return pointer to the first value
+	 */
+	const long* data() const;
+
+	/**
+	 * Sets this matrix to the sum of two matrices of its field and dimensions
+	 * @param a a matrix
+	 * @param b a matrix
+	 */
+	void add(const GFMatrix &a, const GFMatrix &b);
+
+	/**
+	 * Sets this matrix to the difference of two matrices of its field and dimensions
+	 * @param a a matrix
+	 * @param b a matrix
+	 */
+	void subtract(const GFMatrix &a, const GFMatrix &b);
+
+	/**
+	 * Sets this matrix to the product of two matrices of its field
+	 * @param a a matrix with as many columns as b has rows
+	 * @param b a matrix
+	 */
+	void multiply(const GFMatrix &a, const GFMatrix &b);
+
+	/**
+	 * Brings this matrix to row echelon form in place
+	 * @return the rank of the matrix
+	 */
+	int echelon();
+
+	/**
+	 * Returns the rank of this matrix
+	 * @return the rank
+	 */
+	int rank() const;
+
+	/**
+	 * Returns the determinant of this square matrix
+	 * @return the determinant
+	 */
+	GFNumber determinant() const;
+
+	/**
+	 * Solves the system A x = b, where A is this matrix
+	 * @param b a vector with getRows() numbers of the field
+	 * @param x receives a solution with getColumns() numbers; free variables are 0
+	 * @return false if the system has no solution
+	 */
+	bool solve(const GFVector &b, GFVector &x) const;
+
+	/**
+	 * Computes the inverse of this square matrix
+	 * @param result receives the inverse
+	 * @return false if the matrix is singular
+	 */
+	bool inverse(GFMatrix &result) const;
+
+	/**
+	 * Sets the smallest size of square prime field matrices multiplied with Strassen's
+	 * recursion; 0, the default, disables it
+	 * @param size the threshold
+	 */
+	static void setStrassenThreshold(const int &size);
+
+	/**
+	 * Returns the smallest size of square matrices multiplied with Strassen's recursion
+	 * @return the threshold, 0 if disabled
+	 */
+	static int getStrassenThreshold();
+
+
+	///////////////////////////////////   Operators   /////////////////////////////////////////////
+
+	/**
+	 * Overload '=' operator to place one GFMatrix into another
+	 * @param other The GFMatrix object to be placed in this object
+	 * @return A reference to this object after the other matrix was placed into it
+	 */
+	GFMatrix& operator=(const GFMatrix &other);
+
+	/**
+	 * Overload '+=' operator to add a matrix to this matrix
+	 * @param other a matrix of the same field and dimensions
+	 * @return This matrix after the addition
+	 */
+	GFMatrix& operator+=(const GFMatrix &other);
+
+	/**
+	 * Overload '-=' operator to subtract a matrix from this matrix
+	 * @param other a matrix of the same field and dimensions
+	 * @return This matrix after the subtraction
+	 */
+	GFMatrix& operator-=(const GFMatrix &other);
+
+	/**
+	 * Overload '*=' operator to multiply this matrix by another matrix from the right
+	 * @param other a matrix of the same field with as many rows as this matrix has columns
+	 * @return This matrix after the multiplication
+	 */
+	GFMatrix& operator*=(const GFMatrix &other);
+
+	/**
+	 * Overload '*' operator to multiply two matrices
+	 * @param other a matrix of the same field with as many rows as this matrix has columns
+	 * @return the product
+	 */
+	GFMatrix operator*(const GFMatrix &other) const;
+
+	/**
+	 * Overload '<<' operator to print a matrix one row per line
+	 * @param out A reference to the output
+	 * @param matrix the matrix to be printed
+	 * @return the output containing the values of the matrix
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const GFMatrix &matrix);
+
+
+private:
+
+	GField _gField;    // the field of the numbers
+
+	long *_residues;   // 64 byte aligned reduced values, row after row
+
+	int _rows;         // number of rows
+
+	int _columns;      // number of columns
+
+	/**
+	 * Returns the value at a position for writing
+	 * @param i a row
+	 * @param j a column
+	 * @return reference to the value
+	 */
+	long& _at(const int &i, const int &j);
+
+	/**
+	 * Blocked LU elimination to row echelon form, looking for pivots only in the first columns
+	 * @param pivotLimit number of columns in which pivots are looked for
+	 * @param pivotColumns receives the pivot column of each pivot row
+	 * @param swaps receives the number of row swaps
+	 * @return the number of pivots
+	 */
+	int _eliminate(const int &pivotLimit, int *pivotColumns, int *swaps);
+
+	/**
+	 * Solves for the columns after pivotLimit of an eliminated augmented matrix
+	 * @param pivotLimit number of columns of the coefficient part
+	 * @param rank number of pivots
+	 * @param pivotColumns pivot column of each pivot row
+	 * @param result receives a pivotLimit x (getColumns() - pivotLimit) solution
+	 */
+	void _backSubstitute(const int &pivotLimit, const int &rank, const int *pivotColumns,
+						 GFMatrix &result) const;
+
+	/**
+	 * Multiplies two square matrices of even size with one level of Strassen's recursion
+	 * @param a a matrix
+	 * @param b a matrix
+	 */
+	void _strassen(const GFMatrix &a, const GFMatrix &b);
+
+	/**
+	 * Allocates an aligned buffer for size values
+	 * @param size number of values
+	 * @return the buffer
+	 */
+	static long* _allocate(const long &size);
+};
+
+
+#endif //EX1_GFMATRIX_H
@@ -1,6 +1,83 @@
 #include "GFNumber.h"
-#include "GFNumber.h"
+#include "GFFormatter.h"
+#include "GFParser.h"
+#include "FactorStats.h"
+#include "FactorCache.h"
+#include "PrimeSieve.h"
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+// number of steps of rho whose differences are multiplied together before taking a gcd
+static const long RHO_BLOCK = 128;
+
+// number of random polinoms rho tries before giving up
+static const int RHO_ATTEMPTS = 16;
+
+// factors below this bound are found by trial division before rho runs
+static const long TRIAL_DIVISION_BOUND = 256;
+
+// composites below this bound are split by one thread: rho ends before a thread would start
+static const long PARALLEL_RHO_BOUND = 1L << 48;
+
+// number of threads racing rho walks on one composite
+static std::atomic<int> rhoThreads(1);
+
+// numbers below this bound are factored again rather than looked up: it is about as fast
+static const long CACHE_BOUND = 1L << 16;
+
+// cache consulted by factorize and getIsPrime, if any
+static std::atomic<FactorCache*> factorCache(nullptr);
+
+
+/**
+ * splitmix64 generator, seeded once per thread
+ * @return a pseudo random 64 bit number
+ */
+static unsigned long nextRandom()
+{
+	thread_local unsigned long state = std::random_device()() * 0x9E3779B97F4A7C15UL;
+	unsigned long z = (state += 0x9E3779B97F4A7C15UL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+	return z ^ (z >> 31);
+}
+
+
+/**
+ * Montgomery multiplication modulo an odd n < 2^63
+ * @param a a number in [0, n)
+ * @param b a number in [0, n)
+ * @param n the modulus
+ * @param nInverse -n^-1 mod 2^64
+ * @return a * b * 2^-64 mod n
+ */
+static unsigned long montgomeryMultiply(const unsigned long& a, const unsigned long& b,
+										const unsigned long& n, const unsigned long& nInverse)
+{
+	unsigned __int128 t = (unsigned __int128)a * b;
+	unsigned long m = (unsigned long)t * nInverse;
+	unsigned long result = (unsigned long)((t + (unsigned __int128)m * n) >> 64);
+	return (result >= n) ? result - n : result;
+}
+
+
+/**
+ * The polinom from rho Algorithm, evaluated in Montgomery form
+ * @param x a number in [0, n)
+ * @param c the constant of the polinom
+ * @param n the modulus
+ * @param nInverse -n^-1 mod 2^64
+ * @return the value of the polinom (x^2 + c) mod n
+ */
+static unsigned long rhoPolinom(const unsigned long& x, const unsigned long& c,
+								const unsigned long& n, const unsigned long& nInverse)
+{
+	unsigned long result = montgomeryMultiply(x, x, n, nInverse) + c;
+	return (result >= n) ? result - n : result;
+}
 
 
 
@@ -22,12 +99,7 @@ GFNumber::GFNumber():_n(0), _gField(2, 1)
  */
 GFNumber::GFNumber(const long &n):_gField(2, 1)
 {
-	_n = (long)fmod(n, 2);
-	if(_n < 0)
-	{
-		_n += 2;
-	}
-
+	_n = _gField.reduce(n);
 }
 
 
@@ -38,11 +110,7 @@ GFNumber::GFNumber(const long &n):_gField(2, 1)
  */
 GFNumber::GFNumber(const long &n, const GField &field):_gField(field)
 {
-	_n = (long)fmod(n, _gField.getOrder());
-	if(_n < 0)
-	{
-		_n += _gField.getOrder();
-	}
+	_n = _gField.reduce(n);
 }
 
 
@@ -89,233 +157,425 @@ const GField& GFNumber::getField() const
  */
 bool GFNumber::getIsPrime()
 {
-	return GField::isPrime(_n);
+	FactorCache *cache = factorCache.load(std::memory_order_acquire);
+	if(cache == nullptr || _n < CACHE_BOUND)
+	{
+		return GField::isPrime(_n);
+	}
+	bool prime;
+	if(!cache->findPrime(_n, prime))
+	{
+		prime = GField::isPrime(_n);
+		cache->insertPrime(_n, prime);
+	}
+	return prime;
 }
 
 
 /**
- * Returns prime factors of this number
- * @param size number of prime factors
- * @return prime numbers of this number
+ * Raises this number to a power with sliding window exponentiation
+ * @param exponent a non negative exponent
+ * @return this number to the power of exponent
  */
-GFNumber* GFNumber::getPrimeFactors(int *size)
+GFNumber GFNumber::pow(const long& exponent) const
 {
-	GFNumber *primeFactorsArr = new GFNumber[0];
-	long *primeFactorsTemp = new long[0];
-	long num = _n;
-	*size = 0;
+	return GFNumber(_gField.power(_n, exponent), _gField);
+}
 
-	primeFactorsTemp = _getPrimeFactors1(num, primeFactorsTemp, size);
-	if(*size > 0)
-	{
-		delete[] primeFactorsArr;
-		primeFactorsArr = new GFNumber[*size];
-		for(int i = 0; i < *size; i++)
-		{
-			primeFactorsArr[i] = _gField.createNumber(primeFactorsTemp[i]);
-		}
-	}
-	delete[] primeFactorsTemp;
-	return primeFactorsArr;
 
+/**
+ * Raises this number to a power with a Montgomery ladder, which runs the same sequence of
+ * field operations for every exponent
+ * @param exponent a non negative exponent
+ * @return this number to the power of exponent
+ */
+GFNumber GFNumber::powLadder(const long& exponent) const
+{
+	return GFNumber(_gField.powerLadder(_n, exponent), _gField);
 }
 
 
 /**
- * A helper function
- * @param n number
- * @param factors prime factors
- * @param size number of prime factors
- * @return prime factors of the number
+ * Returns the multiplicative inverse of this number
+ * @return the number x such that x * this = 1
+ */
+GFNumber GFNumber::inverse() const
+{
+	return GFNumber(_gField.inverse(_n), _gField);
+}
+
+
+/**
+ * Raises a number to a power with sliding window exponentiation
+ * @param base a number in some field
+ * @param exponent a non negative exponent
+ * @return base to the power of exponent
  */
-long* GFNumber::_getPrimeFactors1(const long& num, long *factors, int *size)
+GFNumber modpow(const GFNumber& base, const long& exponent)
 {
-	long *factorsTemp;
+	return base.pow(exponent);
+}
 
-	if(GField::isPrime(num) || num < 2)
+
+/**
+ * Returns the prime factorization of this number, without any heap allocation
+ * @param factors receives the (prime, exponent) pairs; empty if this number is below 2
+ */
+void GFNumber::getPrimeFactors(FactorList &factors) const
+{
+	factorize(_n, factors);
+}
+
+
+/**
+ * Returns the prime factorization of a number, without any heap allocation
+ * @param n a number
+ * @param factors receives the (prime, exponent) pairs; empty if n is below 2
+ */
+void GFNumber::factorize(const long& n, FactorList &factors)
+{
+	factors.clear();
+	if(n < 2)
 	{
-		return factors;
+		return;
 	}
-	if(num % 2 == 0)
+	FactorStats::add(FactorStats::FACTORIZE_CALLS);
+	FactorStats::Timer timer(FactorStats::FACTORIZE_NANOSECONDS, 64 - __builtin_clzl(n));
+	FactorCache *cache = (n < CACHE_BOUND) ? nullptr : factorCache.load(std::memory_order_acquire);
+	if(cache != nullptr && cache->findFactors(n, factors))
 	{
+		return;
+	}
+	const long rest = _directSearchFactorization(n, factors, TRIAL_DIVISION_BOUND);
+	if(rest > 1)
+	{
+		_getPrimeFactors1(rest, factors);
+	}
+	if(cache != nullptr)
+	{
+		cache->insertFactors(n, factors);
+	}
+}
+
 
-		factors = _directSearchFactorization(num, factors, size);
-		return factors;
+/**
+ * A helper function - splits an odd number without small factors with rho, recursively
+ * @param n number
+ * @param factors receives the prime factors of the number
+ */
+void GFNumber::_getPrimeFactors1(const long& num, FactorList &factors)
+{
+	if(GField::isPrime(num))
+	{
+		factors.add(num);
+		return;
 	}
 
-	long num1 = num, num2 = num;
-	long temp = _rhoAlgorithm(num1);
-	if (temp == -1)
+	long factor = _rhoAlgorithm(num);
+	if(factor == -1)
 	{
-		factors = _directSearchFactorization(num, factors, size);
-		return factors;
+		FactorStats::add(FactorStats::FALLBACKS);
+		_directSearchFactorization(num, factors, num);
+		return;
 	}
+	_getPrimeFactors1(factor, factors);
+	_getPrimeFactors1(num / factor, factors);
+}
 
-	int i = 0;
-	while (true)
+/**
+ * One walk of Pollard's rho with Brent's cycle detection. The differences of a block of steps
+ * are multiplied together mod n so one gcd is taken per block; the cancel flag is polled once
+ * per block.
+ * @param num an odd composite number
+ * @param nInverse -num^-1 mod 2^64
+ * @param c the constant of the polinom, in [1, num)
+ * @param y the start of the walk, in [0, num)
+ * @param cancel set by another walk which already found a factor
+ * @return a factor of num, num itself if the walk failed, or 0 if it was cancelled
+ */
+static long rhoWalk(const long &num, const unsigned long &nInverse, const unsigned long &c,
+					unsigned long y, const std::atomic<bool> &cancel)
+{
+	// the walk runs on Montgomery representatives: multiplying by 2^64 is a bijection mod n
+	// that keeps every gcd with n, so no conversion is needed
+	const unsigned long n = (unsigned long)num;
+	unsigned long x = y, ys = y, q = 1;
+	long g = 1;
+	long r = 1;
+
+	for(; g == 1; r *= 2)
 	{
-		factorsTemp = new long[i + 1];
-		for (int k = 0; k < i; k++)
+		x = y;
+		for(long i = 0; i < r; i++)
 		{
-			factorsTemp[k] = factors[k];
+			y = rhoPolinom(y, c, n, nInverse);
 		}
-		delete[] factors;
-		factors = factorsTemp;
-
-		factors[i] = temp;
-		num2 /= temp;
-		i++;
-		*size = i;
-		if (GField::isPrime(num2))
+		for(long k = 0; k < r && g == 1; k += RHO_BLOCK)
 		{
-			factorsTemp = new long[i + 1];
-			for (int k = 0; k < i ; k++)
+			if(cancel.load(std::memory_order_relaxed))
 			{
-				factorsTemp[k] = factors[k];
+				FactorStats::add(FactorStats::RHO_ITERATIONS, 3 * r - 2 + k);
+				return 0;
 			}
-			delete[] factors;
-			factors = factorsTemp;
-
-			factors[i] = num2;
-			*size = i + 1;
-			return factors;
+			ys = y;
+			const long steps = std::min(RHO_BLOCK, r - k);
+			for(long i = 0; i < steps; i++)
+			{
+				y = rhoPolinom(y, c, n, nInverse);
+				q = montgomeryMultiply(q, (x > y) ? x - y : y - x, n, nInverse);
+			}
+			g = GField::gcd((long)q, num);
 		}
+	}
 
-		temp = _rhoAlgorithm(num2);
-		if (temp == -1)
+	// every round of r walks r steps to its start and up to r steps more
+	FactorStats::add(FactorStats::RHO_ITERATIONS, 2 * r - 2);
+	if(g == num)
+	{
+		// the block overshot: replay it one step at a time from its start
+		do
 		{
-			factors = _directSearchFactorization(num1, factors, size);
+			ys = rhoPolinom(ys, c, n, nInverse);
+			g = GField::gcd((long)((x > ys) ? x - ys : ys - x), num);
+		} while(g == 1);
+	}
+	return g;
+}
 
 
-			delete[] factorsTemp;
-			return factors;
+/**
+ * Runs rho walks with random polinoms until one finds a factor, another racer found one, or
+ * the shared attempts run out
+ * @param num an odd composite number
+ * @param nInverse -num^-1 mod 2^64
+ * @param attempts number of walks started by every racer together
+ * @param limit most walks the racers may start together
+ * @param result receives the first factor found
+ * @param cancel set once a factor was found
+ */
+static void rhoRace(const long &num, const unsigned long &nInverse, std::atomic<int> &attempts,
+					const int &limit, std::atomic<long> &result, std::atomic<bool> &cancel)
+{
+	const unsigned long n = (unsigned long)num;
+	while(!cancel.load(std::memory_order_relaxed) && attempts.fetch_add(1) < limit)
+	{
+		const unsigned long c = nextRandom() % (n - 1) + 1;
+		FactorStats::add(FactorStats::RHO_WALKS);
+		const long g = rhoWalk(num, nInverse, c, nextRandom() % n, cancel);
+		if(g == num)
+		{
+			FactorStats::add(FactorStats::RHO_RESTARTS);
+		}
+		if(g != 0 && g != num)
+		{
+			long none = -1;
+			result.compare_exchange_strong(none, g);
+			cancel.store(true, std::memory_order_relaxed);
+			return;
 		}
 	}
 }
 
+
 /**
- * Helper function - rho Algorithm
- * @param num a number
- * @return a prime factor of num
+ * Helper function - Pollard's rho algorithm with Brent's cycle detection. Above
+ * PARALLEL_RHO_BOUND, getRhoThreads() walks with different polinoms and seeds race on the
+ * composite and the first factor found cancels the others.
+ * @param num an odd composite number
+ * @return a non trivial factor of num, or -1 if every attempt failed
  */
 long GFNumber::_rhoAlgorithm(const long &num)
 {
-	long n = num;
-	std::random_device rd;
-	std::mt19937 mt(rd());
-	std::uniform_int_distribution<long> dist(1, n - 2);
+	const unsigned long n = (unsigned long)num;
+	unsigned long nInverse = n;
+	for(int i = 0; i < 5; i++)
+	{
+		nInverse *= 2 - n * nInverse;
+	}
+	nInverse = 0UL - nInverse;
 
-	long x = dist(mt), p = 1;
-	long y = x;
+	std::atomic<int> attempts(0);
+	std::atomic<long> result(-1);
+	std::atomic<bool> cancel(false);
+	const int threads = (num < PARALLEL_RHO_BOUND) ? 1 : getRhoThreads();
+	const int limit = std::max(RHO_ATTEMPTS, threads);
 
-	while(p == 1)
+	std::vector<std::thread> racers;
+	if(threads > 1)
 	{
-		x = _f(x);
-		y = _f(_f(y));
-		p = std::__gcd(labs(x - y), n);
-		// p = gcd1(labs(x - y), n);
+		racers.reserve(threads - 1);
+		FactorStats::add(FactorStats::RHO_THREADS, threads - 1);
 	}
-
-	if(p == n)
+	for(int i = 1; i < threads; i++)
 	{
-		return -1;
+		racers.emplace_back(rhoRace, std::cref(num), std::cref(nInverse), std::ref(attempts),
+							std::cref(limit), std::ref(result), std::ref(cancel));
 	}
-	return p;
+	rhoRace(num, nInverse, attempts, limit, result, cancel);
+	for(std::thread &racer : racers)
+	{
+		racer.join();
+	}
+	if(result.load() == -1)
+	{
+		FactorStats::add(FactorStats::RHO_FAILURES);
+	}
+	return result.load();
 }
 
+
 /**
- * The polinom from rho Algorithm
- * @param x a number
- * @return the value of the polinom x^2 + 1
+ * Sets the number of threads racing rho walks when a single large composite is split
+ * @param threads number of threads, at least 1
  */
-long GFNumber::_f(const long& x)
+void GFNumber::setRhoThreads(const int &threads)
 {
-	return (long)(pow(x, 2) + 1);
+	assert(threads >= 1);
+	rhoThreads.store(threads);
 }
 
 
 /**
- * direct search factorization algorithm
- * @param n number
- * @param factors prime factors
- * @param size number of prime factors
- * @return prime factors
+ * Returns the number of threads racing rho walks on a single large composite; the default is 1
+ * @return number of threads
  */
-long* GFNumber::_directSearchFactorization(long n, long *factors, int *size)
+int GFNumber::getRhoThreads()
 {
-	int i = 2, j = 0;
+	return rhoThreads.load();
+}
 
-	while (i <= floor(sqrt(n)))
-	{
-		if(n % i == 0)
-		{
-			long *newFactors = new long[j + 1];
-			for(int k = 0; k < j; k++)
-			{
-				newFactors[k] = factors[k];
-			}
-			delete[] factors;
-			factors = newFactors;
+
+/**
+ * Sets the cache consulted by factorize and getIsPrime; the cache must outlive its use
+ * @param cache the cache, or nullptr for none, the default
+ */
+void GFNumber::setFactorCache(FactorCache *cache)
+{
+	factorCache.store(cache, std::memory_order_release);
+}
+
+
+/**
+ * Returns the cache consulted by factorize and getIsPrime
+ * @return the cache, or nullptr for none
+ */
+FactorCache* GFNumber::getFactorCache()
+{
+	return factorCache.load(std::memory_order_acquire);
+}
 
 
-			factors[j] = i;
-			j++;
-			n = (long)(n / floor(i));
+/**
+ * direct search factorization algorithm - divides n by every prime of the small prime table
+ * below bound, then by every odd candidate below bound, while the candidate squared does not
+ * exceed n
+ * @param n number
+ * @param factors receives the prime factors found
+ * @param bound candidates are smaller than bound
+ * @return the remaining cofactor; 1 when n was fully factored
+ */
+long GFNumber::_directSearchFactorization(long n, FactorList &factors, const long &bound)
+{
+	const int twos = __builtin_ctzl(n);
+	if(twos > 0)
+	{
+		factors.add(2, twos);
+		n >>= twos;
+	}
+	const std::vector<int> &smallPrimes = PrimeSieve::getSmallPrimes();
+	long tried = 1;
+	long i = 3;
+	for(; tried < (long)smallPrimes.size(); tried++)
+	{
+		i = smallPrimes[tried];
+		if(i >= bound || i > n / i)
+		{
+			break;
 		}
-		else
+		int exponent = 0;
+		while(n % i == 0)
 		{
-			i++;
+			n /= i;
+			exponent++;
+		}
+		if(exponent > 0)
+		{
+			factors.add(i, exponent);
 		}
 	}
-	if(n > 1)
+	if(tried == (long)smallPrimes.size())
 	{
-		long *newFactors = new long[j + 1];
-		for(int k = 0; k < j; k++)
+		// past the table: every odd candidate
+		for(i = PrimeSieve::SMALL_BOUND + 1; i < bound && i <= n / i; i += 2, tried++)
 		{
-			newFactors[k] = factors[k];
+			int exponent = 0;
+			while(n % i == 0)
+			{
+				n /= i;
+				exponent++;
+			}
+			if(exponent > 0)
+			{
+				factors.add(i, exponent);
+			}
 		}
-		delete[] factors;
-		factors = newFactors;
-
-		factors[j] = n;
 	}
-	if(j)
+	// the candidates tried and the power of two
+	FactorStats::add(FactorStats::TRIAL_DIVISIONS, tried);
+	if(n > 1 && i > n / i)
 	{
-		*size = j + 1;
+		// no factor below sqrt(n) is left, so n is prime
+		factors.add(n);
+		return 1;
 	}
-	return factors;
+	return n;
 }
 
 
+/**
+ * Prints prime factors of this number to the standard output
+ */
+void GFNumber::printFactors()
+{
+	printFactors(std::cout);
+}
 
 
+/**
+ * Prints prime factors of this number as one line, n=p1*p2*...
+ * @param out the output
+ */
+void GFNumber::printFactors(std::ostream &out) const
+{
+	FactorList factors;
+	factorize(_n, factors);
+	char text[GFFormatter::MAX_FACTORS_LENGTH];
+	out.write(text, GFFormatter::formatFactors(text, _n, factors, false) - text);
+}
 
 
 /**
- * Prints prime factors of this number
+ * Appends prime factors of this number as one line, n=p1*p2*... or n=p1^e1*p2^e2*... as the
+ * formatter is set
+ * @param sink the formatter
  */
-void GFNumber::printFactors()
+void GFNumber::printFactors(GFFormatter &sink) const
 {
-
-	GFNumber *primeFactors;
-	int size = 0;
-	primeFactors = getPrimeFactors(&size);
-	std::cout << _n << "=";
-	if(size == 0)
-	{
-		std::cout << _n << "*1" << std::endl;
-		delete[] primeFactors;
-		return;
-	}
-	std::cout << primeFactors[0]._n;
-	for (int i = 1; i < size; i++)
-	{
-		std::cout << "*" << primeFactors[i]._n;
-	}
-	std::cout << std::endl;
-	delete[] primeFactors;
+	printFactors(sink, _n);
+}
 
 
+/**
+ * Appends prime factors of a number as one line, n=p1*p2*... or n=p1^e1*p2^e2*... as the
+ * formatter is set, or n=n*1 if n has less than two prime factors
+ * @param sink the formatter
+ * @param n a number
+ */
+void GFNumber::printFactors(GFFormatter &sink, const long& n)
+{
+	FactorList factors;
+	factorize(n, factors);
+	sink.appendFactors(n, factors);
 }
 
 
@@ -353,37 +613,33 @@ bool GFNumber::operator!=(const GFNumber &other)
  */
 std::ostream& operator<<(std::ostream &out, const GFNumber &gfNumber)
 {
-	out << gfNumber._n << " GF(" << gfNumber._gField.getChar() << "**" << gfNumber._gField.getDegree() << ")";
-	return out;
+	char text[GFFormatter::MAX_NUMBER_LENGTH];
+	return out.write(text, GFFormatter::formatNumber(text, gfNumber) - text);
 }
 
 
 /**
  * Overload '>>' operator from std:cin to receive GFNumber object in the format {n}{GF}
- * @param in A reference to the input
+ * @param in A reference to the input; its failbit is set, and the number left unchanged, if the
+ *        input is malformed or p and l do not describe a field
  * @param gfNumber A number in which the input values will be saved
  * @return the input istream
  */
 std::istream& operator>>(std::istream &in, GFNumber &gfNumber)
 {
-	long n, p, l, tempN;
-	in >> tempN >> p >> l;
-
-	if(p < 0)
+	long p, l, tempN;
+	if(!GFParser::readValue(in, tempN) || !GFParser::readValue(in, p) || !GFParser::readValue(in, l))
 	{
-		p *= (-1);
+		return in;
 	}
-	assert(GField::isPrime(p) && l > 0);
-
-	gfNumber._gField.setChar(p);
-	gfNumber._gField.setDegree(l);
-
-	n = (long)fmod(tempN, gfNumber._gField.getOrder());
-	if(n < 0)
+	if(!GFParser::isValidField(p, l))
 	{
-		n += gfNumber._gField.getOrder();
+		in.setstate(std::ios::failbit);
+		return in;
 	}
-	gfNumber._n = n;
+
+	gfNumber._gField = GField(p, l);
+	gfNumber._n = gfNumber._gField.reduce(tempN);
 	return in;
 }
 
@@ -396,8 +652,7 @@ std::istream& operator>>(std::istream &in, GFNumber &gfNumber)
 GFNumber& GFNumber::operator=(const GFNumber &other)
 {
 	_n = other._n;
-	_gField.setChar(other.getField().getChar());
-	_gField.setDegree(other.getField().getDegree());
+	_gField = other._gField;
 	return *this;
 }
 
@@ -410,7 +665,7 @@ GFNumber& GFNumber::operator=(const GFNumber &other)
 GFNumber GFNumber::operator+(const GFNumber &other)
 {
 	assert(_gField.getOrder() == other.getField().getOrder());
-	GFNumber result(_n + other._n, _gField);
+	GFNumber result(_gField.add(_n, other._n), _gField);
 	return result;
 
 }
@@ -424,7 +679,7 @@ GFNumber GFNumber::operator+(const GFNumber &other)
  */
 GFNumber operator+(const GFNumber& left, const long &right)
 {
-	return GFNumber(left._n + right, left._gField);
+	return GFNumber(left._gField.add(left._n, left._gField.reduce(right)), left._gField);
 }
 
 
@@ -436,12 +691,7 @@ GFNumber operator+(const GFNumber& left, const long &right)
 GFNumber& GFNumber::operator+=(const GFNumber &other)
 {
 	assert(_gField.getOrder() == other.getField().getOrder());
-	long tempN = _n + other._n;
-	_n = tempN % _gField.getOrder();
-	if(_n < 0)
-	{
-		_n += _gField.getOrder();
-	}
+	_n = _gField.add(_n, other._n);
 	return *this;
 }
 
@@ -453,7 +703,7 @@ GFNumber& GFNumber::operator+=(const GFNumber &other)
 GFNumber GFNumber::operator-(const GFNumber &other)
 {
 	assert(_gField.getOrder() == other.getField().getOrder());
-	GFNumber result(_n - other._n, _gField);
+	GFNumber result(_gField.subtract(_n, other._n), _gField);
 	return result;
 
 }
@@ -467,7 +717,7 @@ GFNumber GFNumber::operator-(const GFNumber &other)
  */
 GFNumber operator-(const GFNumber &left, const long &right)
 {
-	return GFNumber(left._n - right, left._gField);
+	return GFNumber(left._gField.subtract(left._n, left._gField.reduce(right)), left._gField);
 }
 
 
@@ -479,12 +729,7 @@ GFNumber operator-(const GFNumber &left, const long &right)
 GFNumber& GFNumber::operator-=(const GFNumber &other)
 {
 	assert(_gField.getOrder() == other.getField().getOrder());
-	long tempN = _n - other._n;
-	_n = tempN % _gField.getOrder();
-	if(_n < 0)
-	{
-		_n += _gField.getOrder();
-	}
+	_n = _gField.subtract(_n, other._n);
 	return *this;
 }
 
@@ -521,7 +766,7 @@ GFNumber& operator+=(GFNumber &left, const long &right)
 GFNumber GFNumber::operator*(const GFNumber &other)
 {
 	assert(_gField.getOrder() == other.getField().getOrder());
-	GFNumber result(_n * other._n, _gField);
+	GFNumber result(_gField.multiply(_n, other._n), _gField);
 	return result;
 }
 
@@ -534,7 +779,7 @@ GFNumber GFNumber::operator*(const GFNumber &other)
  */
 GFNumber operator*(const GFNumber &left, const long &right)
 {
-	return GFNumber(left._n * right, left._gField);
+	return GFNumber(left._gField.multiply(left._n, left._gField.reduce(right)), left._gField);
 }
 
 
@@ -546,12 +791,7 @@ GFNumber operator*(const GFNumber &left, const long &right)
 GFNumber& GFNumber::operator*=(const GFNumber &other)
 {
 	assert(_gField.getOrder() == other.getField().getOrder());
-	long tempN = _n * other._n;
-	_n = tempN % _gField.getOrder();
-	if(_n < 0)
-	{
-		_n += _gField.getOrder();
-	}
+	_n = _gField.multiply(_n, other._n);
 	return *this;
 }
 
@@ -569,6 +809,58 @@ GFNumber& operator*=(GFNumber &left, const long &right)
 }
 
 
+/**
+ * Overload '/' operator to divide two GFNumber objects
+ * @param other The right number; dividing by zero gives zero
+ * @return The result of multiplying this number by the inverse of the right number
+ */
+GFNumber GFNumber::operator/(const GFNumber &other)
+{
+	assert(_gField.getOrder() == other.getField().getOrder());
+	GFNumber result(_gField.multiply(_n, _gField.inverse(other._n)), _gField);
+	return result;
+}
+
+
+/**
+ * Overload '/' operator to divide a GFNumber object by a long number
+ * @param left A GFNumber object
+ * @param right A long number; dividing by zero gives zero
+ * @return The division of the two numbers
+ */
+GFNumber operator/(const GFNumber &left, const long &right)
+{
+	const GField &field = left._gField;
+	return GFNumber(field.multiply(left._n, field.inverse(field.reduce(right))), field);
+}
+
+
+/**
+ * Overload '/=' operator to divide this GFNumber object by another GFNumber object
+ * @param other The GFNumber object to divide this object by
+ * @return This object after division by the other GFNumber object
+ */
+GFNumber& GFNumber::operator/=(const GFNumber &other)
+{
+	assert(_gField.getOrder() == other.getField().getOrder());
+	_n = _gField.multiply(_n, _gField.inverse(other._n));
+	return *this;
+}
+
+
+/**
+ * Overload '/=' operator to divide a GFNumber object by a long number
+ * @param left A GFNumber object
+ * @param right A long number
+ * @return The division result
+ */
+GFNumber& operator/=(GFNumber &left, const long &right)
+{
+	GFNumber gfNumber(right, left._gField);
+	return left /= gfNumber;
+}
+
+
 /**
  * Overload '%' operator to perform modulo operation of two GFNumber objects
  * @param other The right number
@@ -591,12 +883,7 @@ GFNumber GFNumber::operator%(const GFNumber &other)
 GFNumber& GFNumber::operator%=(const GFNumber &other)
 {
 	assert((_gField.getOrder() == other.getField().getOrder()) && other._n != 0);
-	long tempN = _n % other._n;
-	_n = tempN % _gField.getOrder();
-	if(_n < 0)
-	{
-		_n += _gField.getOrder();
-	}
+	_n %= other._n;
 	return *this;
 }
 
@@ -1,10 +1,13 @@
 #ifndef EX1_GFNUMBER_H
 #define EX1_GFNUMBER_H
 #include "GField.h"
+#include "FactorList.h"
 #include <cmath>
 #include <iostream>
 
 class GField;
+class GFFormatter;
+class FactorCache;
 
 /**
  * This class represents a number in a field
@@ -61,23 +64,95 @@ public:
 
 
 	/**
-     * Returns prime factors of this number
-     * @param size number of prime factors
-     * @return prime numbers of this number
+     * Returns the prime factorization of this number, without any heap allocation
+     * @param factors receives the (prime, exponent) pairs; empty if this number is below 2
      */
-	GFNumber* getPrimeFactors(int *size);
+	void getPrimeFactors(FactorList &factors) const;
 
 	/**
-	 * Prints prime factors of this number
+	 * Returns the prime factorization of a number, without any heap allocation
+	 * @param n a number
+	 * @param factors receives the (prime, exponent) pairs; empty if n is below 2
+	 */
+	static void factorize(const long& n, FactorList &factors);
+
+	/**
+	 * Sets the number of threads racing rho walks when a single large composite is split
+	 * @param threads number of threads, at least 1
+	 */
+	static void setRhoThreads(const int &threads);
+
+	/**
+	 * Returns the number of threads racing rho walks on a single large composite; the default is 1
+	 * @return number of threads
+	 */
+	static int getRhoThreads();
+
+	/**
+	 * Sets the cache consulted by factorize and getIsPrime; the cache must outlive its use
+	 * @param cache the cache, or nullptr for none, the default
+	 */
+	static void setFactorCache(FactorCache *cache);
+
+	/**
+	 * Returns the cache consulted by factorize and getIsPrime
+	 * @return the cache, or nullptr for none
+	 */
+	static FactorCache* getFactorCache();
+
+	/**
+	 * Prints prime factors of this number to the standard output
 	 */
 	void printFactors();
 
+	/**
+	 * Prints prime factors of this number as one line, n=p1*p2*...
+	 * @param out the output
+	 */
+	void printFactors(std::ostream &out) const;
+
+	/**
+	 * Appends prime factors of this number as one line, n=p1*p2*... or n=p1^e1*p2^e2*... as the
+	 * formatter is set
+	 * @param sink the formatter
+	 */
+	void printFactors(GFFormatter &sink) const;
+
+	/**
+	 * Appends prime factors of a number as one line, n=p1*p2*... or n=p1^e1*p2^e2*... as the
+	 * formatter is set, or n=n*1 if n has less than two prime factors
+	 * @param sink the formatter
+	 * @param n a number
+	 */
+	static void printFactors(GFFormatter &sink, const long& n);
+
 	/**
 	 * Check if this number is prime
 	 * @return true if this number is prime
 	 */
 	bool getIsPrime();
 
+	/**
+	 * Raises this number to a power with sliding window exponentiation
+	 * @param exponent a non negative exponent
+	 * @return this number to the power of exponent
+	 */
+	GFNumber pow(const long& exponent) const;
+
+	/**
+	 * Raises this number to a power with a Montgomery ladder, which runs the same sequence of
+	 * field operations for every exponent
+	 * @param exponent a non negative exponent
+	 * @return this number to the power of exponent
+	 */
+	GFNumber powLadder(const long& exponent) const;
+
+	/**
+	 * Returns the multiplicative inverse of this number
+	 * @return the number x such that x * this = 1
+	 */
+	GFNumber inverse() const;
+
 
 
 
@@ -187,6 +262,36 @@ public:
      */
 	friend GFNumber& operator*=(GFNumber &left, const long &right);
 
+	/**
+     * Overload '/' operator to divide two GFNumber objects
+     * @param other The right number; dividing by zero gives zero
+     * @return The result of multiplying this number by the inverse of the right number
+     */
+	GFNumber operator/(const GFNumber& other);
+
+	/**
+     * Overload '/' operator to divide a GFNumber object by a long number
+     * @param left A GFNumber object
+     * @param right A long number; dividing by zero gives zero
+     * @return The division of the two numbers
+     */
+	friend GFNumber operator/(const GFNumber& left, const long &right);
+
+	/**
+     * Overload '/=' operator to divide this GFNumber object by another GFNumber object
+     * @param other The GFNumber object to divide this object by
+     * @return This object after division by the other GFNumber object
+     */
+	GFNumber& operator/=(const GFNumber& other);
+
+	/**
+     * Overload '/=' operator to divide a GFNumber object by a long number
+     * @param left A GFNumber object
+     * @param right A long number
+     * @return The division result
+     */
+	friend GFNumber& operator/=(GFNumber &left, const long &right);
+
 
     /**
      * Overload '%' operator to perform modulo operation of two GFNumber objects
@@ -259,7 +364,8 @@ public:
 
     /**
      * Overload '>>' operator from std:cin to receive GFNumber object in the format {n}{GF}
-     * @param in A reference to the input
+     * @param in A reference to the input; its failbit is set, and the number left unchanged, if the
+     *        input is malformed or p and l do not describe a field
      * @param gfNumber A number in which the input values will be saved
      * @return the input istream
      */
@@ -272,39 +378,42 @@ private:
 	GField _gField;      // the field of the number
 
 	/**
-     * direct search factorization algorithm
+     * direct search factorization algorithm - divides n by every prime of the small prime table
+     * below bound, then by every odd candidate below bound, while the candidate squared does not
+     * exceed n
      * @param n number
-     * @param factors prime factors
-     * @param size number of prime factors
-     * @return prime factors
+     * @param factors receives the prime factors found
+     * @param bound candidates are smaller than bound
+     * @return the remaining cofactor; 1 when n was fully factored
      */
-	long* _directSearchFactorization(long n, long *factors, int *size);
+	static long _directSearchFactorization(long n, FactorList &factors, const long &bound);
 
 	/**
-	 * A helper function
+	 * A helper function - splits an odd number without small factors with rho, recursively
 	 * @param n number
-	 * @param factors prime factors
-	 * @param size number of prime factors
-	 * @return prime factors of the number
+	 * @param factors receives the prime factors of the number
 	 */
-	long* _getPrimeFactors1(const long &n, long *factors, int *size);
+	static void _getPrimeFactors1(const long &n, FactorList &factors);
 
     /**
-     * Helper function - rho Algorithm
-     * @param num a number
-     * @return a prime factor of num
+     * Helper function - Pollard's rho algorithm with Brent's cycle detection. Above
+     * PARALLEL_RHO_BOUND, getRhoThreads() walks with different polinoms and seeds race on the
+     * composite and the first factor found cancels the others.
+     * @param num an odd composite number
+     * @return a non trivial factor of num, or -1 if every attempt failed
      */
-	long _rhoAlgorithm(const long &n);
-
-	/**
-     * The polinom from rho Algorithm
-     * @param x a number
-     * @return the value of the polinom x^2 + 1
-     */
-	long _f(const long& x);
+	static long _rhoAlgorithm(const long &n);
 
 
 };
 
+/**
+ * Raises a number to a power with sliding window exponentiation
+ * @param base a number in some field
+ * @param exponent a non negative exponent
+ * @return base to the power of exponent
+ */
+GFNumber modpow(const GFNumber& base, const long& exponent);
+
 
 #endif //EX1_GFNUMBER_H
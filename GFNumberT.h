@@ -0,0 +1,403 @@
+#ifndef EX1_GFNUMBERT_H
+#define EX1_GFNUMBERT_H
+
+#include "GFNumber.h"
+#include "GField.h"
+#include <iostream>
+#include <limits>
+
+
+/**
+ * Returns (base ^ exponent) mod m, usable in constant expressions
+ * @param base a number in [0, m)
+ * @param exponent a non negative exponent
+ * @param m the modulus
+ * @return (base ^ exponent) mod m
+ */
+constexpr long constexprPowMod(long base, long exponent, const long m)
+{
+	long result = 1 % m;
+	while(exponent > 0)
+	{
+		if(exponent & 1)
+		{
+			result = (long)((unsigned __int128)result * (unsigned long)base % (unsigned long)m);
+		}
+		base = (long)((unsigned __int128)base * (unsigned long)base % (unsigned long)m);
+		exponent >>= 1;
+	}
+	return result;
+}
+
+
+/**
+ * Check if a number is prime, usable in constant expressions. Runs trial division by small
+ * candidates and the same deterministic Miller-Rabin witnesses as GField::isPrime.
+ * @param n a number
+ * @return true if n is a prime number
+ */
+constexpr bool constexprIsPrime(const long n)
+{
+	if(n < 2)
+	{
+		return false;
+	}
+	for(long i = 2; i < 100; i++)
+	{
+		if(n % i == 0)
+		{
+			return n == i;
+		}
+	}
+	if(n < 100 * 100)
+	{
+		return true;
+	}
+	long d = n - 1;
+	int s = 0;
+	while((d & 1) == 0)
+	{
+		d >>= 1;
+		s++;
+	}
+	const long witnesses[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+	for(long witness : witnesses)
+	{
+		long x = constexprPowMod(witness % n, d, n);
+		if(witness % n == 0 || x == 1 || x == n - 1)
+		{
+			continue;
+		}
+		bool composite = true;
+		for(int i = 1; i < s && composite; i++)
+		{
+			x = (long)((unsigned __int128)x * (unsigned long)x % (unsigned long)n);
+			composite = (x != n - 1);
+		}
+		if(composite)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Returns p^l, usable in constant expressions
+ * @param p p value of a field
+ * @param l l value of a field
+ * @return p^l, or -1 if it does not fit in a long
+ */
+constexpr long constexprOrder(const long p, const long l)
+{
+	long order = 1;
+	for(long i = 0; i < l; i++)
+	{
+		if(order > std::numeric_limits<long>::max() / p)
+		{
+			return -1;
+		}
+		order *= p;
+	}
+	return order;
+}
+
+
+/**
+ * This class represents a number in the field GF(P**L) fixed at compile time.
+ * Primality and the order are checked when the template is instantiated, numbers of different
+ * fields cannot be mixed, and in GF(P) every reduction is by a constant the compiler turns into
+ * multiply and shift. Extension fields (L > 1) use the polynomial arithmetic of the dynamic
+ * field. A GFNumberT converts to and from the equivalent GFNumber.
+ */
+template<long P, long L = 1>
+class GFNumberT
+{
+	static_assert(constexprIsPrime(P), "the characteristic P of a field must be prime");
+	static_assert(L > 0, "the degree L of a field must be positive");
+	static_assert(constexprOrder(P, L) > 0, "the order P^L of a field must fit in a long");
+
+public:
+
+	static constexpr long ORDER = constexprOrder(P, L);  // order of the field
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Default constructor - the zero of the field
+	 */
+	constexpr GFNumberT():_n(0)
+	{
+
+	}
+
+	/**
+	 * Constructor #1
+	 * @param n A number, reduced into the field
+	 */
+	constexpr GFNumberT(const long &n):_n(_reduce(n))
+	{
+
+	}
+
+	/**
+	 * Constructor #2 - converts a number of the dynamic field GF(P**L)
+	 * @param other a number whose field is GF(P**L)
+	 */
+	explicit GFNumberT(const GFNumber &other):_n(other.getNumber())
+	{
+		assert(other.getField().getChar() == P && other.getField().getDegree() == L);
+	}
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Function returns the value of the number represented by this class
+	 * @return value of the number
+	 */
+	constexpr const long& getNumber() const
+	{
+		return _n;
+	}
+
+	/**
+	 * Function returns the dynamic field equivalent to GF(P**L)
+	 * @return the field of this number
+	 */
+	static const GField& getField()
+	{
+		static const GField field(P, L);
+		return field;
+	}
+
+	/**
+	 * Converts this number into a number of the dynamic field
+	 * @return the equivalent GFNumber
+	 */
+	GFNumber toGFNumber() const
+	{
+		return GFNumber(_n, getField());
+	}
+
+	/**
+	 * Converts this number into a number of the dynamic field
+	 * @return the equivalent GFNumber
+	 */
+	operator GFNumber() const
+	{
+		return toGFNumber();
+	}
+
+	/**
+	 * Raises this number to a power by square and multiply
+	 * @param exponent a non negative exponent
+	 * @return this number to the power of exponent
+	 */
+	constexpr GFNumberT pow(long exponent) const
+	{
+		GFNumberT result(1), base(*this);
+		while(exponent > 0)
+		{
+			if(exponent & 1)
+			{
+				result *= base;
+			}
+			base *= base;
+			exponent >>= 1;
+		}
+		return result;
+	}
+
+	/**
+	 * Returns the multiplicative inverse of this number
+	 * @return the number x such that x * this = 1
+	 */
+	GFNumberT inverse() const
+	{
+		return GFNumberT(getField().inverse(_n));
+	}
+
+
+	///////////////////////////////////   Operators   /////////////////////////////////////////////
+
+	/**
+	 * Overload '+=' operator to add a number of the same field to this number
+	 * @param other a number of the same field
+	 * @return This number after the addition
+	 */
+	constexpr GFNumberT& operator+=(const GFNumberT &other)
+	{
+		if constexpr(L > 1)
+		{
+			_n = getField().add(_n, other._n);
+			return *this;
+		}
+		unsigned long sum = (unsigned long)_n + (unsigned long)other._n;
+		_n = (long)((sum >= (unsigned long)ORDER) ? sum - ORDER : sum);
+		return *this;
+	}
+
+	/**
+	 * Overload '-=' operator to subtract a number of the same field from this number
+	 * @param other a number of the same field
+	 * @return This number after the subtraction
+	 */
+	constexpr GFNumberT& operator-=(const GFNumberT &other)
+	{
+		if constexpr(L > 1)
+		{
+			_n = getField().subtract(_n, other._n);
+			return *this;
+		}
+		_n = (_n >= other._n) ? _n - other._n : _n - other._n + ORDER;
+		return *this;
+	}
+
+	/**
+	 * Overload '*=' operator to multiply this number by a number of the same field
+	 * @param other a number of the same field
+	 * @return This number after the multiplication
+	 */
+	constexpr GFNumberT& operator*=(const GFNumberT &other)
+	{
+		_n = _multiply(_n, other._n);
+		return *this;
+	}
+
+	/**
+	 * Overload '/=' operator to divide this number by a number of the same field
+	 * @param other an invertible number of the same field
+	 * @return This number after the division
+	 */
+	GFNumberT& operator/=(const GFNumberT &other)
+	{
+		return *this *= other.inverse();
+	}
+
+	/**
+	 * Overload '+' operator to add two numbers of the same field
+	 * @param other a number of the same field
+	 * @return The sum of the numbers
+	 */
+	constexpr GFNumberT operator+(const GFNumberT &other) const
+	{
+		GFNumberT result(*this);
+		return result += other;
+	}
+
+	/**
+	 * Overload '-' operator to subtract two numbers of the same field
+	 * @param other a number of the same field
+	 * @return The difference of the numbers
+	 */
+	constexpr GFNumberT operator-(const GFNumberT &other) const
+	{
+		GFNumberT result(*this);
+		return result -= other;
+	}
+
+	/**
+	 * Overload '*' operator to multiply two numbers of the same field
+	 * @param other a number of the same field
+	 * @return The product of the numbers
+	 */
+	constexpr GFNumberT operator*(const GFNumberT &other) const
+	{
+		GFNumberT result(*this);
+		return result *= other;
+	}
+
+	/**
+	 * Overload '/' operator to divide two numbers of the same field
+	 * @param other an invertible number of the same field
+	 * @return The quotient of the numbers
+	 */
+	GFNumberT operator/(const GFNumberT &other) const
+	{
+		GFNumberT result(*this);
+		return result /= other;
+	}
+
+	/**
+	 * Overload '==' operator to check if two numbers of the same field are equal
+	 * @param other a number of the same field
+	 * @return True if the numbers are equal. Otherwise, false.
+	 */
+	constexpr bool operator==(const GFNumberT &other) const
+	{
+		return _n == other._n;
+	}
+
+	/**
+	 * Overload '!=' operator to check if two numbers of the same field are not equal
+	 * @param other a number of the same field
+	 * @return True if the numbers are not equal. Otherwise, false.
+	 */
+	constexpr bool operator!=(const GFNumberT &other) const
+	{
+		return _n != other._n;
+	}
+
+	/**
+	 * Overload '<<' operator to print the number in the format "{n} GF(p**l)"
+	 * @param out A reference to the output
+	 * @param number the number to be printed
+	 * @return the output containing the value of number
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const GFNumberT &number)
+	{
+		out << number._n << " GF(" << P << "**" << L << ")";
+		return out;
+	}
+
+
+private:
+
+	long _n;  // the value of the number, in [0, ORDER)
+
+	/**
+	 * Reduces any number into [0, ORDER) as GField::reduce does
+	 * @param n a number
+	 * @return n mod ORDER for a non negative n; a negative n is the additive inverse of the
+	 *         element of -n, which only for L = 1 is n mod ORDER
+	 */
+	static constexpr long _reduce(const long &n)
+	{
+		if constexpr(L > 1)
+		{
+			if(n < 0)
+			{
+				return getField().reduce(n);
+			}
+		}
+		long r = n % ORDER;
+		return (r < 0) ? r + ORDER : r;
+	}
+
+	/**
+	 * Multiplies two reduced values. In GF(P) below 2^32 the product fits in 64 bits and the
+	 * constant modulus becomes a multiply and shift; above it a 128 bit Barrett step with a
+	 * compile time reciprocal is used.
+	 * @param a a number in [0, ORDER)
+	 * @param b a number in [0, ORDER)
+	 * @return a * b mod ORDER
+	 */
+	static constexpr long _multiply(const long &a, const long &b)
+	{
+		if constexpr(L > 1)
+		{
+			return getField().multiply(a, b);
+		}
+		if(ORDER <= (1L << 32))
+		{
+			return (long)((unsigned long)a * (unsigned long)b % (unsigned long)ORDER);
+		}
+		constexpr unsigned __int128 mu = ~(unsigned __int128)0 / (unsigned long)ORDER;
+		return GField::barrettReduce((unsigned __int128)a * (unsigned long)b, (unsigned long)(mu >> 64),
+									 (unsigned long)mu, ORDER);
+	}
+};
+
+
+#endif //EX1_GFNUMBERT_H
@@ -0,0 +1,311 @@
+#include "GFParser.h"
+#include "GField.h"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// number of (p, l) pairs whose validity every thread remembers
+static const int FIELD_CACHE_SIZE = 64;
+
+// longest run of characters a number of a long may take, with its sign
+static const int MAX_DIGITS = 21;
+
+
+/**
+ * Check if a character separates numbers on a line
+ * @param c a character
+ * @return true for spaces, tabs, carriage returns, vertical tabs and form feeds
+ */
+static inline bool isBlank(const char &c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+
+/**
+ * Converts a number at the start of a text
+ * @param begin first byte of the number, possibly a sign
+ * @param end end of the text
+ * @param value receives the number
+ * @return the byte after the number, or nullptr if the text does not start with a number which
+ *         fits in a long
+ */
+static const char* parseValue(const char *begin, const char *end, long &value)
+{
+	if(begin != end && *begin == '+' && end - begin > 1 && begin[1] != '-')
+	{
+		begin++;
+	}
+	std::from_chars_result result = std::from_chars(begin, end, value);
+	if(result.ec != std::errc())
+	{
+		return nullptr;
+	}
+	return result.ptr;
+}
+
+
+/**
+ * Finds the end of a line
+ * @param position a byte of the line
+ * @param end end of the text
+ * @return the newline which ends the line, or end
+ */
+static const char* skipLine(const char *position, const char *end)
+{
+	const char *newline = (const char*)memchr(position, '\n', end - position);
+	return (newline == nullptr) ? end : newline;
+}
+
+
+////////////////////////////////////  Constructors & Destructor  //////////////////////////////////
+
+/**
+ * Constructor - parses a file descriptor, mapping it if it is a regular file
+ * @param descriptor an open file descriptor; it is not closed by the parser
+ */
+GFParser::GFParser(const int &descriptor):_descriptor(descriptor), _position(nullptr),
+	_end(nullptr), _complete(nullptr), _base(0), _mapping(nullptr), _mappedLength(0), _eof(false)
+{
+	struct stat status;
+	if(fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0)
+	{
+		const off_t start = lseek(descriptor, 0, SEEK_CUR);
+		void *mapping = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if(mapping != MAP_FAILED && start >= 0 && start <= status.st_size)
+		{
+			madvise(mapping, (size_t)status.st_size, MADV_SEQUENTIAL);
+			_mapping = mapping;
+			_mappedLength = (size_t)status.st_size;
+			_position = (const char*)mapping + start;
+			_end = _complete = (const char*)mapping + status.st_size;
+			_base = start;
+			_descriptor = -1;
+			_eof = true;
+			return;
+		}
+		if(mapping != MAP_FAILED)
+		{
+			munmap(mapping, (size_t)status.st_size);
+		}
+	}
+	_buffer.resize(BUFFER_SIZE);
+	_position = _end = _complete = _buffer.data();
+}
+
+
+/**
+ * Constructor - parses text in memory, without copying it
+ * @param text the text
+ * @param length number of bytes of the text
+ */
+GFParser::GFParser(const char *text, const size_t &length):_descriptor(-1), _position(text),
+	_end(text + length), _complete(text + length), _base(0), _mapping(nullptr), _mappedLength(0), _eof(true)
+{
+
+}
+
+
+/**
+ * Destructor
+ */
+GFParser::~GFParser()
+{
+	if(_mapping != nullptr)
+	{
+		munmap(_mapping, _mappedLength);
+	}
+}
+
+
+////////////////////////////////////   Class Methods    ///////////////////////////////////////////
+
+/**
+ * Parses the next line. A line with two numbers, more than three, anything but numbers, or
+ * an n p l triple whose p and l do not describe a field gets an error.
+ * @param line receives the line
+ * @return false if the input ended
+ */
+bool GFParser::next(Line &line)
+{
+	while(_position == _complete && !_eof)
+	{
+		_fill();
+	}
+	if(_position == _end)
+	{
+		return false;
+	}
+
+	line.offset = _base;
+	const char *lineEnd = _parseLine(_position, _end, line);
+	const char *nextLine = (lineEnd == _end) ? _end : lineEnd + 1;
+	_base += nextLine - _position;
+	_position = nextLine;
+	return true;
+}
+
+
+/**
+ * Check if the input is memory mapped
+ * @return true if the input is scanned in place
+ */
+bool GFParser::isMapped() const
+{
+	return _mapping != nullptr;
+}
+
+
+/**
+ * Reads one number from a stream: skips white space, then converts the longest run of
+ * sign and digit characters
+ * @param in the input; its failbit is set if no number could be read
+ * @param value receives the number
+ * @return true if a number was read
+ */
+bool GFParser::readValue(std::istream &in, long &value)
+{
+	std::istream::sentry sentry(in);
+	if(!sentry)
+	{
+		return false;
+	}
+	std::streambuf *buffer = in.rdbuf();
+	char digits[MAX_DIGITS + 1];
+	int length = 0;
+	int c = buffer->sgetc();
+	while(c != std::char_traits<char>::eof() && length <= MAX_DIGITS &&
+		  ((c >= '0' && c <= '9') || ((c == '-' || c == '+') && length == 0)))
+	{
+		digits[length++] = (char)c;
+		c = buffer->snextc();
+	}
+	if(c == std::char_traits<char>::eof())
+	{
+		in.setstate(std::ios::eofbit);
+	}
+	if(parseValue(digits, digits + length, value) != digits + length)
+	{
+		in.setstate(std::ios::failbit);
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Check if p and l describe a field, remembering the answer for recently seen pairs
+ * @param p p value of the field
+ * @param l l value of the field
+ * @return true if GField(p, l) may be constructed
+ */
+bool GFParser::isValidField(const long &p, const long &l)
+{
+	struct Entry
+	{
+		long p, l;
+		bool valid;
+	};
+	thread_local Entry cache[FIELD_CACHE_SIZE] = {};
+
+	Entry &entry = cache[((unsigned long)p * 31 + (unsigned long)l) % FIELD_CACHE_SIZE];
+	if(entry.p != p || entry.l != l || entry.p == 0)
+	{
+		entry.p = p;
+		entry.l = l;
+		entry.valid = GField::isValid(p, l);
+	}
+	return entry.valid;
+}
+
+
+/**
+ * Moves the incomplete line to the front of the buffer and reads after it
+ */
+void GFParser::_fill()
+{
+	const size_t kept = _end - _position;
+	if(kept == _buffer.size())
+	{
+		// a single line fills the buffer
+		const size_t offset = _position - _buffer.data();
+		_buffer.resize(_buffer.size() * 2);
+		_position = _buffer.data() + offset;
+	}
+	memmove(_buffer.data(), _position, kept);
+	_position = _buffer.data();
+	_end = _position + kept;
+
+	ssize_t count;
+	do
+	{
+		count = read(_descriptor, _buffer.data() + kept, _buffer.size() - kept);
+	} while(count < 0 && errno == EINTR);
+	if(count <= 0)
+	{
+		_eof = true;
+		_complete = _end;
+		return;
+	}
+	_end += count;
+	const char *newline = (const char*)memrchr(_position, '\n', _end - _position);
+	_complete = (newline == nullptr) ? _position : newline + 1;
+}
+
+
+/**
+ * Parses the numbers of one line
+ * @param begin first byte of the line
+ * @param end end of the text; the line ends at the first newline before it
+ * @param line receives the numbers or the error; offset must already be set
+ * @return the newline which ends the line, or end
+ */
+const char* GFParser::_parseLine(const char *begin, const char *end, Line &line)
+{
+	line.count = 0;
+	line.error = nullptr;
+	const char *position = begin;
+	const char *starts[MAX_VALUES];
+	while(true)
+	{
+		while(position != end && isBlank(*position))
+		{
+			position++;
+		}
+		if(position == end || *position == '\n')
+		{
+			break;
+		}
+		line.errorOffset = line.offset + (position - begin);
+		if(line.count == MAX_VALUES)
+		{
+			line.error = "more than three numbers";
+			return skipLine(position, end);
+		}
+		starts[line.count] = position;
+		const char *after = parseValue(position, end, line.values[line.count]);
+		if(after == nullptr || (after != end && *after != '\n' && !isBlank(*after)))
+		{
+			line.error = "malformed number";
+			return skipLine(position, end);
+		}
+		line.count++;
+		position = after;
+	}
+
+	line.errorOffset = line.offset;
+	if(line.count == 2)
+	{
+		line.error = "expected a number or an n p l triple";
+	}
+	else if(line.count == 3 && !isValidField(line.values[1], line.values[2]))
+	{
+		line.errorOffset = line.offset + (starts[1] - begin);
+		line.error = "p and l do not describe a field";
+	}
+	return position;
+}
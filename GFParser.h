@@ -0,0 +1,132 @@
+#ifndef EX1_GFPARSER_H
+#define EX1_GFPARSER_H
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/**
+ * This class parses numbers given one per line, either n alone or an n p l triple, as fast as
+ * the text can be scanned.
+ * A regular file is memory mapped and scanned in place; pipes and other descriptors are read
+ * into a large buffer which only moves the last, incomplete line when it is refilled. Numbers
+ * are converted with std::from_chars, free of locales and of iostream formatting.
+ * Malformed lines do not stop the parse: they are returned with an error and the byte offset
+ * where it was found.
+ */
+class GFParser
+{
+
+public:
+
+	static const size_t BUFFER_SIZE = 1 << 20;  // bytes read at once when the input is not mapped
+
+	static const int MAX_VALUES = 3;            // most numbers a line may hold, n p l
+
+	/**
+	 * A parsed line
+	 */
+	struct Line
+	{
+		long values[MAX_VALUES];  // the numbers of the line
+		int count;                // number of numbers, 0 for a blank line
+		long offset;              // byte offset of the line in the input
+		long errorOffset;         // byte offset of the error, if any
+		const char *error;        // what is wrong with the line, nullptr if it is well formed
+	};
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor - parses a file descriptor, mapping it if it is a regular file
+	 * @param descriptor an open file descriptor; it is not closed by the parser
+	 */
+	explicit GFParser(const int &descriptor);
+
+	/**
+	 * Constructor - parses text in memory, without copying it
+	 * @param text the text
+	 * @param length number of bytes of the text
+	 */
+	GFParser(const char *text, const size_t &length);
+
+	/**
+	 * Destructor
+	 */
+	~GFParser();
+
+	GFParser(const GFParser &other) = delete;
+
+	GFParser& operator=(const GFParser &other) = delete;
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Parses the next line. A line with two numbers, more than three, anything but numbers, or
+	 * an n p l triple whose p and l do not describe a field gets an error.
+	 * @param line receives the line
+	 * @return false if the input ended
+	 */
+	bool next(Line &line);
+
+	/**
+	 * Check if the input is memory mapped
+	 * @return true if the input is scanned in place
+	 */
+	bool isMapped() const;
+
+	/**
+	 * Reads one number from a stream: skips white space, then converts the longest run of
+	 * sign and digit characters
+	 * @param in the input; its failbit is set if no number could be read
+	 * @param value receives the number
+	 * @return true if a number was read
+	 */
+	static bool readValue(std::istream &in, long &value);
+
+	/**
+	 * Check if p and l describe a field, remembering the answer for recently seen pairs
+	 * @param p p value of the field
+	 * @param l l value of the field
+	 * @return true if GField(p, l) may be constructed
+	 */
+	static bool isValidField(const long &p, const long &l);
+
+
+private:
+
+	int _descriptor;            // the input, -1 when parsing memory or a mapping
+
+	std::vector<char> _buffer;  // the read buffer when the input is not mapped
+
+	const char *_position;      // start of the next line
+
+	const char *_end;           // end of the available text
+
+	const char *_complete;      // end of the last complete line of the available text
+
+	long _base;                 // byte offset of _position in the input
+
+	void *_mapping;             // the mapped file, nullptr if the input is not mapped
+
+	size_t _mappedLength;       // length of the mapping
+
+	bool _eof;                  // whether the descriptor has no more bytes
+
+	/**
+	 * Moves the incomplete line to the front of the buffer and reads after it
+	 */
+	void _fill();
+
+	/**
+	 * Parses the numbers of one line
+	 * @param begin first byte of the line
+	 * @param end end of the text; the line ends at the first newline before it
+	 * @param line receives the numbers or the error; offset must already be set
+	 * @return the newline which ends the line, or end
+	 */
+	static const char* _parseLine(const char *begin, const char *end, Line &line);
+};
+
+
+#endif //EX1_GFPARSER_H
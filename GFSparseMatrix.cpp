@@ -0,0 +1,740 @@
+#include "GFSparseMatrix.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <random>
+
+typedef unsigned __int128 Pair;  // two blocks of 64 vectors side by side
+
+// number of bits of a block
+static const int BLOCK = 64;
+
+// number of random starts tried before block Lanczos gives up
+static const int LANCZOS_ATTEMPTS = 4;
+
+
+/**
+ * Multiplies two 64 x 64 matrices, c = a * b. Row i of a matrix is a word whose bit j is the
+ * entry (i, j).
+ * @param a a matrix
+ * @param b a matrix
+ * @param c receives the product; it may be a or b
+ */
+static void multiply64(const unsigned long *a, const unsigned long *b, unsigned long *c)
+{
+	unsigned long product[BLOCK];
+	for(int i = 0; i < BLOCK; i++)
+	{
+		unsigned long row = 0;
+		for(unsigned long bits = a[i]; bits != 0; bits &= bits - 1)
+		{
+			row ^= b[__builtin_ctzl(bits)];
+		}
+		product[i] = row;
+	}
+	memcpy(c, product, sizeof(product));
+}
+
+
+/**
+ * Multiplies the transpose of a block by a block, c = x^T y, with one table per byte of x
+ * @param x n words
+ * @param y n words
+ * @param n length of the blocks
+ * @param c receives the 64 x 64 product
+ * @param tables one set of tables per thread, grown as needed and kept for the next call
+ */
+static void transposeMultiply(const unsigned long *x, const unsigned long *y, const long &n,
+							  unsigned long *c, std::vector<unsigned long> &tables)
+{
+	const size_t size = (size_t)ThreadPool::getThreads() * 8 * 256;
+	if(tables.size() < size)
+	{
+		tables.resize(size);
+	}
+	const int chunks = ThreadPool::parallelFor(n, 8, [&](const int &index, const long &begin, const long &end)
+	{
+		unsigned long *table = tables.data() + index * 8 * 256;
+		memset(table, 0, sizeof(unsigned long) * 8 * 256);
+		for(long k = begin; k < end; k++)
+		{
+			const unsigned long word = x[k];
+			for(int b = 0; b < 8; b++)
+			{
+				table[b * 256 + ((word >> (8 * b)) & 255)] ^= y[k];
+			}
+		}
+	});
+	for(int index = 1; index < chunks; index++)
+	{
+		for(int t = 0; t < 8 * 256; t++)
+		{
+			tables[t] ^= tables[index * 8 * 256 + t];
+		}
+	}
+	for(int b = 0; b < 8; b++)
+	{
+		for(int i = 0; i < 8; i++)
+		{
+			unsigned long row = 0;
+			for(int byte = 0; byte < 256; byte++)
+			{
+				if((byte >> i) & 1)
+				{
+					row ^= tables[b * 256 + byte];
+				}
+			}
+			c[8 * b + i] = row;
+		}
+	}
+}
+
+
+/**
+ * Adds the product of a block by a 64 x 64 matrix to a block, y ^= v * m
+ * @param v n words
+ * @param m a 64 x 64 matrix
+ * @param y n words
+ * @param n length of the blocks
+ */
+static void multiplyAccumulate(const unsigned long *v, const unsigned long *m, unsigned long *y,
+							   const long &n)
+{
+	unsigned long tables[8][256];
+	for(int b = 0; b < 8; b++)
+	{
+		tables[b][0] = 0;
+		for(int byte = 1; byte < 256; byte++)
+		{
+			const int low = __builtin_ctz(byte);
+			tables[b][byte] = tables[b][byte & (byte - 1)] ^ m[8 * b + low];
+		}
+	}
+	ThreadPool::parallelFor(n, 8, [&](const int &, const long &begin, const long &end)
+	{
+		for(long k = begin; k < end; k++)
+		{
+			const unsigned long word = v[k];
+			y[k] ^= tables[0][word & 255] ^ tables[1][(word >> 8) & 255] ^
+					tables[2][(word >> 16) & 255] ^ tables[3][(word >> 24) & 255] ^
+					tables[4][(word >> 32) & 255] ^ tables[5][(word >> 40) & 255] ^
+					tables[6][(word >> 48) & 255] ^ tables[7][word >> 56];
+		}
+	});
+}
+
+
+/**
+ * Chooses the columns S of this iteration and inverts the submatrix of v^T A v they select.
+ * Columns left out of the previous iteration are tried first, as the recurrence needs every
+ * column in S or in the previous S.
+ * @param vtav the 64 x 64 matrix v^T A v
+ * @param s receives the chosen columns
+ * @param lastS the columns chosen by the previous iteration
+ * @param lastDimension number of columns chosen by the previous iteration
+ * @param inverse receives S (S^T v^T A v S)^-1 S^T
+ * @return number of chosen columns, or -1 if the iteration broke down
+ */
+static int chooseColumns(const unsigned long *vtav, int *s, const int *lastS, const int &lastDimension,
+						 unsigned long *inverse)
+{
+	unsigned long left[BLOCK], right[BLOCK];
+	int order[BLOCK];
+	for(int i = 0; i < BLOCK; i++)
+	{
+		left[i] = vtav[i];
+		right[i] = 1UL << i;
+	}
+	unsigned long lastMask = 0;
+	for(int i = 0; i < lastDimension; i++)
+	{
+		order[BLOCK - 1 - i] = lastS[i];
+		lastMask |= 1UL << lastS[i];
+	}
+	for(int i = 0, j = 0; i < BLOCK; i++)
+	{
+		if(!((lastMask >> i) & 1))
+		{
+			order[j++] = i;
+		}
+	}
+
+	// Gauss-Jordan on [vtav | I], visiting the rows in that order
+	int dimension = 0;
+	for(int i = 0; i < BLOCK; i++)
+	{
+		const unsigned long mask = 1UL << order[i];
+		const int pivot = order[i];
+		int j = i;
+		while(j < BLOCK && !(left[order[j]] & mask))
+		{
+			j++;
+		}
+		if(j < BLOCK)
+		{
+			std::swap(left[pivot], left[order[j]]);
+			std::swap(right[pivot], right[order[j]]);
+			for(int k = 0; k < BLOCK; k++)
+			{
+				if(k != pivot && (left[k] & mask))
+				{
+					left[k] ^= left[pivot];
+					right[k] ^= right[pivot];
+				}
+			}
+			s[dimension++] = pivot;
+			continue;
+		}
+		// no pivot in this column: use the right half instead and drop the row
+		j = i;
+		while(j < BLOCK && !(right[order[j]] & mask))
+		{
+			j++;
+		}
+		if(j == BLOCK)
+		{
+			return -1;
+		}
+		std::swap(left[pivot], left[order[j]]);
+		std::swap(right[pivot], right[order[j]]);
+		for(int k = 0; k < BLOCK; k++)
+		{
+			if(k != pivot && (right[k] & mask))
+			{
+				left[k] ^= left[pivot];
+				right[k] ^= right[pivot];
+			}
+		}
+		left[pivot] = right[pivot] = 0;
+	}
+	memcpy(inverse, right, sizeof(right));
+
+	unsigned long covered = lastMask;
+	for(int i = 0; i < dimension; i++)
+	{
+		covered |= 1UL << s[i];
+	}
+	return (covered == ~0UL) ? dimension : -1;
+}
+
+
+/**
+ * Column elimination over 128 columns: finds an invertible T such that the columns of rows * T
+ * outside a set of pivots are zero
+ * @param rows count rows of 128 bits
+ * @param count number of rows
+ * @param transform receives T, 128 rows of 128 bits
+ * @return the columns of rows * T which are zero
+ */
+static Pair eliminateColumns(const Pair *rows, const long &count, Pair *transform)
+{
+	for(int i = 0; i < 2 * BLOCK; i++)
+	{
+		transform[i] = (Pair)1 << i;
+	}
+	Pair zero = ~(Pair)0;
+	for(long r = 0; r < count && zero != 0; r++)
+	{
+		Pair row = 0;
+		for(Pair bits = rows[r]; bits != 0; bits &= bits - 1)
+		{
+			const unsigned long low = (unsigned long)bits;
+			row ^= transform[(low != 0) ? __builtin_ctzl(low) : BLOCK + __builtin_ctzl((unsigned long)(bits >> 64))];
+		}
+		row &= zero;
+		if(row == 0)
+		{
+			continue;
+		}
+		const unsigned long low = (unsigned long)row;
+		const int pivot = (low != 0) ? __builtin_ctzl(low) : BLOCK + __builtin_ctzl((unsigned long)(row >> 64));
+		const Pair others = row & ~((Pair)1 << pivot);
+		for(int i = 0; i < 2 * BLOCK; i++)
+		{
+			if((transform[i] >> pivot) & 1)
+			{
+				transform[i] ^= others;
+			}
+		}
+		zero &= ~((Pair)1 << pivot);
+	}
+	return zero;
+}
+
+
+/**
+ * Multiplies rows of 128 bits by a 128 x 128 matrix
+ * @param rows count rows, replaced by the products
+ * @param count number of rows
+ * @param transform the matrix
+ */
+static void transformRows(Pair *rows, const long &count, const Pair *transform)
+{
+	ThreadPool::parallelFor(count, 64, [&](const int &, const long &begin, const long &end)
+	{
+		for(long r = begin; r < end; r++)
+		{
+			Pair row = 0;
+			for(Pair bits = rows[r]; bits != 0; bits &= bits - 1)
+			{
+				const unsigned long low = (unsigned long)bits;
+				row ^= transform[(low != 0) ? __builtin_ctzl(low) : BLOCK + __builtin_ctzl((unsigned long)(bits >> 64))];
+			}
+			rows[r] = row;
+		}
+	});
+}
+
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Constructor - a matrix with no rows
+ * @param columns number of columns
+ */
+GFSparseMatrix::GFSparseMatrix(const int &columns):_columns(columns), _rowStarts(1, 0)
+{
+	assert(columns >= 0);
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Appends a row. A column given twice cancels out.
+ * @param columns the columns of the non zero entries, in [0, getColumns())
+ * @param count number of columns
+ */
+void GFSparseMatrix::addRow(const int *columns, const int &count)
+{
+	std::vector<int> sorted(columns, columns + count);
+	std::sort(sorted.begin(), sorted.end());
+	for(int i = 0; i < count; i++)
+	{
+		assert(sorted[i] >= 0 && sorted[i] < _columns);
+		if(i + 1 < count && sorted[i + 1] == sorted[i])
+		{
+			i++;
+			continue;
+		}
+		_entries.push_back(sorted[i]);
+	}
+	_rowStarts.push_back((long)_entries.size());
+}
+
+
+/**
+ * Returns the number of rows of this matrix
+ * @return number of rows
+ */
+int GFSparseMatrix::getRows() const
+{
+	return (int)_rowStarts.size() - 1;
+}
+
+
+/**
+ * Returns the number of columns of this matrix
+ * @return number of columns
+ */
+int GFSparseMatrix::getColumns() const
+{
+	return _columns;
+}
+
+
+/**
+ * Returns the number of non zero entries of this matrix
+ * @return number of entries
+ */
+long GFSparseMatrix::getEntries() const
+{
+	return (long)_entries.size();
+}
+
+
+/**
+ * Returns an entry
+ * @param i a row in [0, getRows())
+ * @param j a column in [0, getColumns())
+ * @return true if the entry is 1
+ */
+bool GFSparseMatrix::get(const int &i, const int &j) const
+{
+	assert(i >= 0 && i < getRows() && j >= 0 && j < _columns);
+	return std::binary_search(_entries.begin() + _rowStarts[i], _entries.begin() + _rowStarts[i + 1], j);
+}
+
+
+/**
+ * Multiplies 64 vectors by this matrix, y = B x
+ * @param x getColumns() words
+ * @param y receives getRows() words
+ */
+void GFSparseMatrix::multiply(const unsigned long *x, unsigned long *y) const
+{
+	const long rows = getRows();
+	const long perRow = (rows > 0) ? getEntries() / rows : 0;
+	ThreadPool::parallelFor(rows, perRow, [&](const int &, const long &begin, const long &end)
+	{
+		for(long r = begin; r < end; r++)
+		{
+			unsigned long sum = 0;
+			for(long k = _rowStarts[r]; k < _rowStarts[r + 1]; k++)
+			{
+				sum ^= x[_entries[k]];
+			}
+			y[r] = sum;
+		}
+	});
+}
+
+
+/**
+ * Multiplies 64 vectors by the transpose of this matrix, x = B^T y
+ * @param y getRows() words
+ * @param x receives getColumns() words
+ */
+void GFSparseMatrix::multiplyTransposed(const unsigned long *y, unsigned long *x) const
+{
+	std::vector<unsigned long> partial;
+	_multiplyTransposed(y, x, partial);
+}
+
+
+/**
+ * Finds up to 64 independent dependencies between the columns, sets of columns whose sum is 0
+ * @param dependencies receives getColumns() words; bit k of word j is set if column j
+ *        belongs to dependency k
+ * @return number of dependencies found, in the low bits of the words
+ */
+int GFSparseMatrix::nullSpace(std::vector<unsigned long> &dependencies) const
+{
+	if(_columns <= DENSE_LIMIT)
+	{
+		return _denseNullSpace(dependencies);
+	}
+	std::random_device device;
+	int found = -1;
+	for(int attempt = 0; attempt < LANCZOS_ATTEMPTS && found < 0; attempt++)
+	{
+		found = _blockLanczos(dependencies, ((unsigned long)device() << 32) | device());
+	}
+	if(found < 0)
+	{
+		dependencies.assign(_columns, 0);
+		return 0;
+	}
+	return found;
+}
+
+
+/**
+ * One run of block Lanczos from a random start
+ * @param dependencies receives the dependencies
+ * @param seed seed of the random start
+ * @return number of dependencies found, or -1 if the iteration broke down
+ */
+int GFSparseMatrix::_blockLanczos(std::vector<unsigned long> &dependencies, const unsigned long &seed) const
+{
+	const long n = _columns;
+	std::vector<unsigned long> v[3], next(n), x(n, 0), start(n), rhs(n), scratch(getRows()), partial, tables;
+	for(int k = 0; k < 3; k++)
+	{
+		v[k].assign(n, 0);
+	}
+
+	// solve A x = A y for a random y; then x - y is in the null space of A = B^T B
+	std::mt19937_64 random(seed);
+	for(long k = 0; k < n; k++)
+	{
+		start[k] = random();
+	}
+	_multiplySymmetric(start.data(), v[0].data(), scratch.data(), partial);
+	rhs = v[0];
+
+	// index 0 belongs to the current iteration, 1 and 2 to the previous ones
+	unsigned long vtav[2][BLOCK] = {}, vta2v[2][BLOCK] = {}, inverse[3][BLOCK] = {};
+	unsigned long d[BLOCK], e[BLOCK], f[BLOCK], f2[BLOCK];
+	int s[2][BLOCK];
+	int lastDimension = BLOCK;
+	unsigned long lastMask = ~0UL;
+	for(int i = 0; i < BLOCK; i++)
+	{
+		s[1][i] = i;
+	}
+
+	const long maxIterations = n / (BLOCK - 1) + 100;
+	for(long iteration = 0; ; iteration++)
+	{
+		if(iteration > maxIterations)
+		{
+			return -1;
+		}
+		_multiplySymmetric(v[0].data(), next.data(), scratch.data(), partial);
+		transposeMultiply(v[0].data(), next.data(), n, vtav[0], tables);
+		transposeMultiply(next.data(), next.data(), n, vta2v[0], tables);
+		bool finished = true;
+		for(int i = 0; i < BLOCK && finished; i++)
+		{
+			finished = (vtav[0][i] == 0);
+		}
+		if(finished)
+		{
+			break;
+		}
+
+		const int dimension = chooseColumns(vtav[0], s[0], s[1], lastDimension, inverse[0]);
+		if(dimension <= 0)
+		{
+			return -1;
+		}
+		unsigned long mask = 0;
+		for(int i = 0; i < dimension; i++)
+		{
+			mask |= 1UL << s[0][i];
+		}
+
+		// v_next = A v S S^T + v D + v_1 E + v_2 F (Montgomery's recurrence)
+		for(int i = 0; i < BLOCK; i++)
+		{
+			d[i] = (vta2v[0][i] & mask) ^ vtav[0][i];
+		}
+		multiply64(inverse[0], d, d);
+		for(int i = 0; i < BLOCK; i++)
+		{
+			d[i] ^= 1UL << i;
+		}
+		multiply64(inverse[1], vtav[0], e);
+		for(int i = 0; i < BLOCK; i++)
+		{
+			e[i] &= mask;
+		}
+		multiply64(vtav[1], inverse[1], f);
+		for(int i = 0; i < BLOCK; i++)
+		{
+			f[i] ^= 1UL << i;
+		}
+		multiply64(inverse[2], f, f);
+		for(int i = 0; i < BLOCK; i++)
+		{
+			f2[i] = ((vta2v[1][i] & lastMask) ^ vtav[1][i]) & mask;
+		}
+		multiply64(f, f2, f);
+
+		for(long k = 0; k < n; k++)
+		{
+			next[k] &= mask;
+		}
+		multiplyAccumulate(v[0].data(), d, next.data(), n);
+		multiplyAccumulate(v[1].data(), e, next.data(), n);
+		multiplyAccumulate(v[2].data(), f, next.data(), n);
+
+		// x += v W v^T rhs
+		transposeMultiply(v[0].data(), rhs.data(), n, d, tables);
+		multiply64(inverse[0], d, d);
+		multiplyAccumulate(v[0].data(), d, x.data(), n);
+
+		v[2].swap(v[1]);
+		v[1].swap(v[0]);
+		v[0].swap(next);
+		memcpy(inverse[2], inverse[1], sizeof(inverse[1]));
+		memcpy(inverse[1], inverse[0], sizeof(inverse[0]));
+		memcpy(vtav[1], vtav[0], sizeof(vtav[0]));
+		memcpy(vta2v[1], vta2v[0], sizeof(vta2v[0]));
+		memcpy(s[1], s[0], sizeof(s[0]));
+		lastMask = mask;
+		lastDimension = dimension;
+	}
+
+	// the null space of B lies in the span of [x - y | v_m]; combine those 128 columns so that
+	// their product with B vanishes, then keep the independent non zero combinations
+	std::vector<Pair> candidates(n), products(getRows());
+	for(long k = 0; k < n; k++)
+	{
+		candidates[k] = ((Pair)v[0][k] << BLOCK) | (x[k] ^ start[k]);
+	}
+	{
+		std::vector<unsigned long> low(n), high(n), lowProduct(getRows()), highProduct(getRows());
+		for(long k = 0; k < n; k++)
+		{
+			low[k] = (unsigned long)candidates[k];
+			high[k] = (unsigned long)(candidates[k] >> BLOCK);
+		}
+		multiply(low.data(), lowProduct.data());
+		multiply(high.data(), highProduct.data());
+		for(long r = 0; r < getRows(); r++)
+		{
+			products[r] = ((Pair)highProduct[r] << BLOCK) | lowProduct[r];
+		}
+	}
+	Pair transform[2 * BLOCK];
+	const Pair zero = eliminateColumns(products.data(), getRows(), transform);
+	transformRows(candidates.data(), n, transform);
+	for(long k = 0; k < n; k++)
+	{
+		candidates[k] &= zero;
+	}
+	const Pair dependent = eliminateColumns(candidates.data(), n, transform);
+	transformRows(candidates.data(), n, transform);
+
+	// the pivots of the second elimination are the independent non zero dependencies
+	int count = 0;
+	int positions[BLOCK];
+	for(int i = 0; i < 2 * BLOCK && count < BLOCK; i++)
+	{
+		if(!((dependent >> i) & 1))
+		{
+			positions[count++] = i;
+		}
+	}
+	dependencies.assign(n, 0);
+	for(long k = 0; k < n; k++)
+	{
+		unsigned long word = 0;
+		for(int i = 0; i < count; i++)
+		{
+			word |= (unsigned long)((candidates[k] >> positions[i]) & 1) << i;
+		}
+		dependencies[k] = word;
+	}
+	return count;
+}
+
+
+/**
+ * Gaussian elimination on the columns, for small matrices
+ * @param dependencies receives the dependencies
+ * @return number of dependencies found
+ */
+int GFSparseMatrix::_denseNullSpace(std::vector<unsigned long> &dependencies) const
+{
+	const long rows = getRows();
+	const long rowWords = (rows + BLOCK - 1) / BLOCK, tagWords = (_columns + BLOCK - 1) / BLOCK;
+	const long width = rowWords + tagWords;
+	// every column with the identity appended, so that its reductions are tracked
+	std::vector<unsigned long> columns(width * _columns, 0);
+	for(long r = 0; r < rows; r++)
+	{
+		for(long k = _rowStarts[r]; k < _rowStarts[r + 1]; k++)
+		{
+			columns[_entries[k] * width + r / BLOCK] |= 1UL << (r % BLOCK);
+		}
+	}
+	for(long j = 0; j < _columns; j++)
+	{
+		columns[j * width + rowWords + j / BLOCK] |= 1UL << (j % BLOCK);
+	}
+
+	dependencies.assign(_columns, 0);
+	std::vector<long> pivotOf(rows, -1);
+	int count = 0;
+	for(long j = 0; j < _columns && count < BLOCK; j++)
+	{
+		unsigned long *column = columns.data() + j * width;
+		long word = 0;
+		while(true)
+		{
+			while(word < rowWords && column[word] == 0)
+			{
+				word++;
+			}
+			if(word == rowWords)
+			{
+				// reduced to zero: the tracked columns sum to zero
+				for(long c = 0; c < _columns; c++)
+				{
+					if((column[rowWords + c / BLOCK] >> (c % BLOCK)) & 1)
+					{
+						dependencies[c] |= 1UL << count;
+					}
+				}
+				count++;
+				break;
+			}
+			const long row = word * BLOCK + __builtin_ctzl(column[word]);
+			if(pivotOf[row] < 0)
+			{
+				pivotOf[row] = j;
+				break;
+			}
+			const unsigned long *pivot = columns.data() + pivotOf[row] * width;
+			for(long w = word; w < width; w++)
+			{
+				column[w] ^= pivot[w];
+			}
+		}
+	}
+	return count;
+}
+
+
+/**
+ * Multiplies 64 vectors by B^T B
+ * @param x getColumns() words
+ * @param y receives getColumns() words
+ * @param scratch getRows() words
+ * @param partial passed to _multiplyTransposed
+ */
+void GFSparseMatrix::_multiplySymmetric(const unsigned long *x, unsigned long *y, unsigned long *scratch,
+									   std::vector<unsigned long> &partial) const
+{
+	multiply(x, scratch);
+	_multiplyTransposed(scratch, y, partial);
+}
+
+
+/**
+ * Multiplies 64 vectors by the transpose of this matrix, x = B^T y
+ * @param y getRows() words
+ * @param x receives getColumns() words
+ * @param partial one buffer of getColumns() words per thread but the first, grown as needed
+ *        and kept for the next call
+ */
+void GFSparseMatrix::_multiplyTransposed(const unsigned long *y, unsigned long *x,
+										 std::vector<unsigned long> &partial) const
+{
+	// every thread scatters its rows into a buffer of its own, then the buffers are summed
+	const long rows = getRows();
+	const long perRow = (rows > 0) ? getEntries() / rows : 0;
+	const size_t size = (size_t)(ThreadPool::getThreads() - 1) * _columns;
+	if(partial.size() < size)
+	{
+		partial.resize(size);
+	}
+	const int chunks = ThreadPool::parallelFor(rows, perRow,
+		[&](const int &index, const long &begin, const long &end)
+	{
+		unsigned long *target = (index == 0) ? x : partial.data() + (index - 1) * (long)_columns;
+		memset(target, 0, sizeof(unsigned long) * _columns);
+		for(long r = begin; r < end; r++)
+		{
+			const unsigned long word = y[r];
+			for(long k = _rowStarts[r]; k < _rowStarts[r + 1]; k++)
+			{
+				target[_entries[k]] ^= word;
+			}
+		}
+	});
+	if(chunks == 0)
+	{
+		memset(x, 0, sizeof(unsigned long) * _columns);
+	}
+	else if(chunks > 1)
+	{
+		ThreadPool::parallelFor(_columns, chunks, [&](const int &, const long &begin, const long &end)
+		{
+			for(int index = 1; index < chunks; index++)
+			{
+				const unsigned long *source = partial.data() + (index - 1) * (long)_columns;
+				for(long j = begin; j < end; j++)
+				{
+					x[j] ^= source[j];
+				}
+			}
+		});
+	}
+}
@@ -0,0 +1,132 @@
+#ifndef EX1_GFSPARSEMATRIX_H
+#define EX1_GFSPARSEMATRIX_H
+
+#include <vector>
+
+/**
+ * This class represents a sparse matrix over GF(2), stored in compressed sparse row (CSR) form:
+ * the column indices of the non zero entries of every row, one row after the other.
+ * Vectors are processed 64 at a time: a block of 64 vectors of length k is an array of k words
+ * whose bit i holds the entries of vector i.
+ * nullSpace finds dependencies between the columns with Montgomery's block Lanczos algorithm;
+ * its sparse products are split over ThreadPool::getThreads() threads.
+ */
+class GFSparseMatrix
+{
+
+public:
+
+	static const int DENSE_LIMIT = 1024;  // matrices with at most this many columns are solved densely
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor - a matrix with no rows
+	 * @param columns number of columns
+	 */
+	explicit GFSparseMatrix(const int &columns);
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Appends a row. A column given twice cancels out.
+	 * @param columns the columns of the non zero entries, in [0, getColumns())
+	 * @param count number of columns
+	 */
+	void addRow(const int *columns, const int &count);
+
+	/**
+	 * Returns the number of rows of this matrix
+	 * @return number of rows
+	 */
+	int getRows() const;
+
+	/**
+	 * Returns the number of columns of this matrix
+	 * @return number of columns
+	 */
+	int getColumns() const;
+
+	/**
+	 * Returns the number of non zero entries of this matrix
+	 * @return number of entries
+	 */
+	long getEntries() const;
+
+	/**
+	 * Returns an entry
+	 * @param i a row in [0, getRows())
+	 * @param j a column in [0, getColumns())
+	 * @return true if the entry is 1
+	 */
+	bool get(const int &i, const int &j) const;
+
+	/**
+	 * Multiplies 64 vectors by this matrix, y = B x
+	 * @param x getColumns() words
+	 * @param y receives getRows() words
+	 */
+	void multiply(const unsigned long *x, unsigned long *y) const;
+
+	/**
+	 * Multiplies 64 vectors by the transpose of this matrix, x = B^T y
+	 * @param y getRows() words
+	 * @param x receives getColumns() words
+	 */
+	void multiplyTransposed(const unsigned long *y, unsigned long *x) const;
+
+	/**
+	 * Finds up to 64 independent dependencies between the columns, sets of columns whose sum is 0
+	 * @param dependencies receives getColumns() words; bit k of word j is set if column j
+	 *        belongs to dependency k
+	 * @return number of dependencies found, in the low bits of the words
+	 */
+	int nullSpace(std::vector<unsigned long> &dependencies) const;
+
+
+private:
+
+	int _columns;                    // number of columns
+
+	std::vector<long> _rowStarts;    // position of the first entry of every row, and the end
+
+	std::vector<int> _entries;       // column of every non zero entry, row after row
+
+	/**
+	 * One run of block Lanczos from a random start
+	 * @param dependencies receives the dependencies
+	 * @param seed seed of the random start
+	 * @return number of dependencies found, or -1 if the iteration broke down
+	 */
+	int _blockLanczos(std::vector<unsigned long> &dependencies, const unsigned long &seed) const;
+
+	/**
+	 * Gaussian elimination on the columns, for small matrices
+	 * @param dependencies receives the dependencies
+	 * @return number of dependencies found
+	 */
+	int _denseNullSpace(std::vector<unsigned long> &dependencies) const;
+
+	/**
+	 * Multiplies 64 vectors by B^T B
+	 * @param x getColumns() words
+	 * @param y receives getColumns() words
+	 * @param scratch getRows() words
+	 * @param partial passed to _multiplyTransposed
+	 */
+	void _multiplySymmetric(const unsigned long *x, unsigned long *y, unsigned long *scratch,
+							std::vector<unsigned long> &partial) const;
+
+	/**
+	 * Multiplies 64 vectors by the transpose of this matrix, x = B^T y
+	 * @param y getRows() words
+	 * @param x receives getColumns() words
+	 * @param partial one buffer of getColumns() words per thread but the first, grown as needed
+	 *        and kept for the next call
+	 */
+	void _multiplyTransposed(const unsigned long *y, unsigned long *x,
+							 std::vector<unsigned long> &partial) const;
+};
+
+
+#endif //EX1_GFSPARSEMATRIX_H
@@ -0,0 +1,602 @@
+#include "GFTransform.h"
+#include "FactorList.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+// transform primes c * 2^k + 1 just below 2^62 for multiplication over other fields; the
+// product of the three exceeds length * (p - 1)^2 for every 62 bit p and length below 2^53
+static const long CRT_PRIMES[] = {4179340454199820289L,   // 29 * 2^57 + 1
+								  3188548536178311169L,   // 177 * 2^54 + 1
+								  4512606826625236993L};  // 501 * 2^53 + 1
+
+// log2 of the product of the CRT primes, rounded down
+static const double CRT_BITS = 185;
+
+
+/**
+ * Montgomery multiplication modulo an odd p < 2^62
+ * @param a a number in [0, p)
+ * @param b a number in [0, p)
+ * @param p the modulus
+ * @param pInverse -p^-1 mod 2^64
+ * @return a * b * 2^-64 mod p
+ */
+static inline unsigned long montgomeryMultiply(const unsigned long &a, const unsigned long &b,
+											   const unsigned long &p, const unsigned long &pInverse)
+{
+	unsigned __int128 t = (unsigned __int128)a * b;
+	unsigned long m = (unsigned long)t * pInverse;
+	unsigned long u = (unsigned long)((t + (unsigned __int128)m * p) >> 64);
+	return (u >= p) ? u - p : u;
+}
+
+
+/**
+ * Adds two numbers modulo p
+ * @param a a number in [0, p)
+ * @param b a number in [0, p)
+ * @param p the modulus
+ * @return a + b mod p
+ */
+static inline unsigned long addMod(const unsigned long &a, const unsigned long &b,
+								   const unsigned long &p)
+{
+	unsigned long sum = a + b;
+	return (sum >= p) ? sum - p : sum;
+}
+
+
+/**
+ * Subtracts two numbers modulo p
+ * @param a a number in [0, p)
+ * @param b a number in [0, p)
+ * @param p the modulus
+ * @return a - b mod p
+ */
+static inline unsigned long subtractMod(const unsigned long &a, const unsigned long &b,
+										const unsigned long &p)
+{
+	return (a >= b) ? a - b : a + p - b;
+}
+
+
+/**
+ * One radix-2 decimation in frequency stage over a range
+ * @param a the values
+ * @param length number of values in the range, a multiple of 2h
+ * @param h half of the butterfly span
+ * @param roots twiddle table
+ * @param p the modulus
+ * @param pInverse -p^-1 mod 2^64
+ */
+static void forwardRadix2(unsigned long *a, const long &length, const long &h,
+						  const unsigned long *roots, const unsigned long &p,
+						  const unsigned long &pInverse)
+{
+	const unsigned long *w = roots + h;
+	for(long s = 0; s < length; s += 2 * h)
+	{
+		for(long j = 0; j < h; j++)
+		{
+			unsigned long u = a[s + j], v = a[s + j + h];
+			a[s + j] = addMod(u, v, p);
+			a[s + j + h] = montgomeryMultiply(subtractMod(u, v, p), w[j], p, pInverse);
+		}
+	}
+}
+
+
+/**
+ * Two fused decimation in frequency stages (spans 4q and 2q) over a range
+ * @param a the values
+ * @param length number of values in the range, a multiple of 4q
+ * @param q a quarter of the butterfly span
+ * @param roots twiddle table
+ * @param p the modulus
+ * @param pInverse -p^-1 mod 2^64
+ */
+static void forwardRadix4(unsigned long *a, const long &length, const long &q,
+						  const unsigned long *roots, const unsigned long &p,
+						  const unsigned long &pInverse)
+{
+	const unsigned long imaginary = roots[3];  // w_4
+	const unsigned long *w1 = roots + 2 * q, *w2 = roots + q;
+	for(long s = 0; s < length; s += 4 * q)
+	{
+		unsigned long *x = a + s;
+		for(long j = 0; j < q; j++)
+		{
+			unsigned long a0 = x[j], a1 = x[j + q], a2 = x[j + 2 * q], a3 = x[j + 3 * q];
+			unsigned long sum02 = addMod(a0, a2, p), sum13 = addMod(a1, a3, p);
+			unsigned long difference02 = subtractMod(a0, a2, p);
+			unsigned long difference13 = montgomeryMultiply(subtractMod(a1, a3, p), imaginary, p,
+															 pInverse);
+			unsigned long w3 = montgomeryMultiply(w1[j], w2[j], p, pInverse);
+			x[j] = addMod(sum02, sum13, p);
+			x[j + q] = montgomeryMultiply(subtractMod(sum02, sum13, p), w2[j], p, pInverse);
+			x[j + 2 * q] = montgomeryMultiply(addMod(difference02, difference13, p), w1[j], p,
+											  pInverse);
+			x[j + 3 * q] = montgomeryMultiply(subtractMod(difference02, difference13, p), w3, p,
+											  pInverse);
+		}
+	}
+}
+
+
+/**
+ * One radix-2 decimation in time stage over a range, the inverse of forwardRadix2 up to a
+ * factor 2
+ * @param a the values
+ * @param length number of values in the range, a multiple of 2h
+ * @param h half of the butterfly span
+ * @param roots inverse twiddle table
+ * @param p the modulus
+ * @param pInverse -p^-1 mod 2^64
+ */
+static void inverseRadix2(unsigned long *a, const long &length, const long &h,
+						  const unsigned long *roots, const unsigned long &p,
+						  const unsigned long &pInverse)
+{
+	const unsigned long *w = roots + h;
+	for(long s = 0; s < length; s += 2 * h)
+	{
+		for(long j = 0; j < h; j++)
+		{
+			unsigned long u = a[s + j];
+			unsigned long v = montgomeryMultiply(a[s + j + h], w[j], p, pInverse);
+			a[s + j] = addMod(u, v, p);
+			a[s + j + h] = subtractMod(u, v, p);
+		}
+	}
+}
+
+
+/**
+ * Two fused decimation in time stages (spans 2q and 4q) over a range, the inverse of
+ * forwardRadix4 up to a factor 4
+ * @param a the values
+ * @param length number of values in the range, a multiple of 4q
+ * @param q a quarter of the butterfly span
+ * @param roots inverse twiddle table
+ * @param p the modulus
+ * @param pInverse -p^-1 mod 2^64
+ */
+static void inverseRadix4(unsigned long *a, const long &length, const long &q,
+						  const unsigned long *roots, const unsigned long &p,
+						  const unsigned long &pInverse)
+{
+	const unsigned long imaginary = roots[3];  // w_4^-1
+	const unsigned long *w1 = roots + 2 * q, *w2 = roots + q;
+	for(long s = 0; s < length; s += 4 * q)
+	{
+		unsigned long *x = a + s;
+		for(long j = 0; j < q; j++)
+		{
+			unsigned long w3 = montgomeryMultiply(w1[j], w2[j], p, pInverse);
+			unsigned long c1 = montgomeryMultiply(x[j + q], w2[j], p, pInverse);
+			unsigned long c2 = montgomeryMultiply(x[j + 2 * q], w1[j], p, pInverse);
+			unsigned long c3 = montgomeryMultiply(x[j + 3 * q], w3, p, pInverse);
+			unsigned long t0 = addMod(x[j], c1, p), t1 = subtractMod(x[j], c1, p);
+			unsigned long t2 = addMod(c2, c3, p);
+			unsigned long t3 = montgomeryMultiply(subtractMod(c2, c3, p), imaginary, p, pInverse);
+			x[j] = addMod(t0, t2, p);
+			x[j + q] = addMod(t1, t3, p);
+			x[j + 2 * q] = subtractMod(t0, t2, p);
+			x[j + 3 * q] = subtractMod(t1, t3, p);
+		}
+	}
+}
+
+
+/**
+ * Returns the span of the stages of a transform, largest first: a radix-4 stage pair is stored
+ * as its quarter span q > 0, a trailing radix-2 stage as -1
+ * @param logLength log of the length
+ * @param stages receives the stages
+ * @return number of stages
+ */
+static int planStages(const int &logLength, long *stages)
+{
+	int count = 0;
+	int m = logLength;
+	for(; m >= 2; m -= 2)
+	{
+		stages[count++] = 1L << (m - 2);
+	}
+	if(m == 1)
+	{
+		stages[count++] = -1;
+	}
+	return count;
+}
+
+
+/**
+ * Returns the span of a stage as planned by planStages
+ * @param stage a stage
+ * @return number of values one butterfly group touches
+ */
+static long stageSpan(const long &stage)
+{
+	return (stage > 0) ? 4 * stage : 2;
+}
+
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Constructor
+ * @param field a field GF(p) with p = c * 2^k + 1, k >= 1 and p < 2^62
+ */
+GFTransform::GFTransform(const GField &field):_field(field), _p((unsigned long)field.getChar())
+{
+	assert(isTransformField(field));
+	_maxLog = __builtin_ctzl(_p - 1);
+
+	// Newton iteration doubles the number of correct low bits of p^-1 every step
+	unsigned long inverse = _p;
+	for(int i = 0; i < 5; i++)
+	{
+		inverse *= 2 - _p * inverse;
+	}
+	_pInverse = 0UL - inverse;
+	unsigned long r = (0UL - _p) % _p;
+	_r2 = (unsigned long)GField::mulMod((long)r, (long)r, (long)_p);
+
+	// a generator g of the multiplicative group gives the root g^((p - 1) / 2^k)
+	FactorList factors;
+	GFNumber::factorize((long)_p - 1, factors);
+	long generator = 2;
+	for(bool found = false; !found; )
+	{
+		found = true;
+		for(int i = 0; i < factors.size() && found; i++)
+		{
+			if(GField::powMod(generator, ((long)_p - 1) / factors.getPrime(i), (long)_p) == 1)
+			{
+				found = false;
+				generator++;
+			}
+		}
+	}
+	_maxRoot = (unsigned long)GField::powMod(generator, (long)(_p >> _maxLog), (long)_p);
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Check if a field supports the transform
+ * @param field a field
+ * @return true if l = 1, p < 2^62 and p - 1 is even
+ */
+bool GFTransform::isTransformField(const GField &field)
+{
+	return field.getDegree() == 1 && field.getChar() > 2 && field.getChar() < (1L << 62);
+}
+
+
+/**
+ * Function returns the field of this transform
+ * @return field of this transform
+ */
+const GField& GFTransform::getField() const
+{
+	return _field;
+}
+
+
+/**
+ * Returns the largest log of a transform length in this field
+ * @return k, the power of 2 in p - 1
+ */
+const int& GFTransform::getMaxLog() const
+{
+	return _maxLog;
+}
+
+
+/**
+ * Forward transform in place; the output is in bit reversed order
+ * @param values 2^logLength reduced values of the field
+ * @param logLength log of the length, at most getMaxLog()
+ */
+void GFTransform::forward(long *values, const int &logLength) const
+{
+	assert(logLength >= 0 && logLength <= _maxLog);
+	const unsigned long *roots = _twiddles(logLength)->roots.data();
+	unsigned long *a = (unsigned long*)values;
+	const long length = 1L << logLength;
+	const long block = std::min(length, 1L << BLOCK_LOG);
+
+	long stages[64];
+	const int count = planStages(logLength, stages);
+	int i = 0;
+	for(; i < count && stageSpan(stages[i]) > block; i++)
+	{
+		forwardRadix4(a, length, stages[i], roots, _p, _pInverse);
+	}
+	// every remaining stage stays inside one block, so finish each block while it is cached
+	for(long start = 0; start < length; start += block)
+	{
+		for(int j = i; j < count; j++)
+		{
+			if(stages[j] > 0)
+			{
+				forwardRadix4(a + start, block, stages[j], roots, _p, _pInverse);
+			}
+			else
+			{
+				forwardRadix2(a + start, block, 1, roots, _p, _pInverse);
+			}
+		}
+	}
+}
+
+
+/**
+ * Inverse transform in place, scaled by 1/2^logLength; the input is in bit reversed order
+ * @param values 2^logLength reduced values of the field
+ * @param logLength log of the length, at most getMaxLog()
+ */
+void GFTransform::inverse(long *values, const int &logLength) const
+{
+	// 2^-logLength in Montgomery form
+	unsigned long scale = (unsigned long)GField::powMod(1L << logLength, (long)_p - 2, (long)_p);
+	_inverse(values, logLength, _toMontgomery(scale));
+}
+
+
+/**
+ * Multiplies two polynomials of this field
+ * @param a coefficients of the first polynomial, constant term first
+ * @param sizeA number of coefficients of a, at least 1
+ * @param b coefficients of the second polynomial
+ * @param sizeB number of coefficients of b, at least 1
+ * @param result receives the sizeA + sizeB - 1 coefficients of the product; it may not
+ *        overlap a or b
+ */
+void GFTransform::convolve(const long *a, const long &sizeA, const long *b, const long &sizeB,
+						   long *result) const
+{
+	assert(sizeA > 0 && sizeB > 0);
+	const long size = sizeA + sizeB - 1;
+	int logLength = 0;
+	while((1L << logLength) < size)
+	{
+		logLength++;
+	}
+	assert(logLength <= _maxLog && "product too long for this field");
+	const long length = 1L << logLength;
+
+	std::vector<long> transformA(length, 0);
+	std::copy(a, a + sizeA, transformA.begin());
+	forward(transformA.data(), logLength);
+
+	const bool square = (a == b && sizeA == sizeB);
+	std::vector<long> transformB;
+	if(!square)
+	{
+		transformB.assign(length, 0);
+		std::copy(b, b + sizeB, transformB.begin());
+		forward(transformB.data(), logLength);
+	}
+	const long *other = square ? transformA.data() : transformB.data();
+	for(long i = 0; i < length; i++)
+	{
+		transformA[i] = (long)montgomeryMultiply((unsigned long)transformA[i], (unsigned long)other[i],
+												 _p, _pInverse);
+	}
+
+	// the pointwise products carry a factor 2^-64, which the final scale removes with 1/length
+	unsigned long scale = (unsigned long)GField::powMod(length, (long)_p - 2, (long)_p);
+	_inverse(transformA.data(), logLength, _toMontgomery(_toMontgomery(scale)));
+	std::copy(transformA.begin(), transformA.begin() + size, result);
+}
+
+
+/**
+ * Multiplies two polynomials over any prime field, directly if the field supports a long
+ * enough transform and with three transform primes and the CRT otherwise
+ * @param a coefficients of the first polynomial, constant term first
+ * @param sizeA number of coefficients of a, at least 1
+ * @param b coefficients of the second polynomial
+ * @param sizeB number of coefficients of b, at least 1
+ * @param result receives the sizeA + sizeB - 1 coefficients of the product
+ * @param field a field GF(p)
+ */
+void GFTransform::convolve(const long *a, const long &sizeA, const long *b, const long &sizeB,
+						   long *result, const GField &field)
+{
+	assert(field.getDegree() == 1);
+	const long size = sizeA + sizeB - 1;
+	const long m = field.getChar();
+	if(isTransformField(field) && (1L << __builtin_ctzl(m - 1)) >= size)
+	{
+		GFTransform(field).convolve(a, sizeA, b, sizeB, result);
+		return;
+	}
+	// the exact coefficients are below min(sizeA, sizeB) * (m - 1)^2
+	assert(std::log2((double)std::min(sizeA, sizeB)) + 2 * std::log2((double)m) < CRT_BITS);
+
+	std::vector<long> residues[3];
+	std::vector<long> reducedA(sizeA), reducedB(sizeB);
+	for(int k = 0; k < 3; k++)
+	{
+		const long prime = CRT_PRIMES[k];
+		for(long i = 0; i < sizeA; i++)
+		{
+			reducedA[i] = a[i] % prime;
+		}
+		for(long i = 0; i < sizeB; i++)
+		{
+			reducedB[i] = b[i] % prime;
+		}
+		residues[k].resize(size);
+		GFTransform(GField(prime)).convolve(reducedA.data(), sizeA, reducedB.data(), sizeB,
+											residues[k].data());
+	}
+
+	// Garner: x = r0 + p0 * k1 + p0 * p1 * k2 with k1 < p1 and k2 < p2
+	const long p0 = CRT_PRIMES[0], p1 = CRT_PRIMES[1], p2 = CRT_PRIMES[2];
+	const long inverse01 = GField::powMod(p0 % p1, p1 - 2, p1);
+	const long inverse012 = GField::powMod(GField::mulMod(p0 % p2, p1 % p2, p2), p2 - 2, p2);
+	const long p0ModM = p0 % m, p01ModM = GField::mulMod(p0 % m, p1 % m, m);
+	for(long i = 0; i < size; i++)
+	{
+		const long r0 = residues[0][i], r1 = residues[1][i], r2 = residues[2][i];
+		long k1 = r1 - r0 % p1;
+		k1 = GField::mulMod((k1 < 0) ? k1 + p1 : k1, inverse01, p1);
+		long k2 = r2 - r0 % p2;
+		k2 = (k2 < 0) ? k2 + p2 : k2;
+		k2 -= GField::mulMod(p0 % p2, k1 % p2, p2);
+		k2 = GField::mulMod((k2 < 0) ? k2 + p2 : k2, inverse012, p2);
+
+		unsigned long x = (unsigned long)(r0 % m) + (unsigned long)GField::mulMod(p0ModM, k1 % m, m);
+		x %= (unsigned long)m;
+		x += (unsigned long)GField::mulMod(p01ModM, k2 % m, m);
+		result[i] = (long)(x % (unsigned long)m);
+	}
+}
+
+
+/**
+ * Multiplies two polynomials given as vectors of coefficients of the same prime field
+ * @param a coefficients of the first polynomial, constant term first
+ * @param b coefficients of the second polynomial
+ * @return the a.size() + b.size() - 1 coefficients of the product
+ */
+GFVector GFTransform::multiply(const GFVector &a, const GFVector &b)
+{
+	assert(a.getField().getOrder() == b.getField().getOrder());
+	assert(a.size() > 0 && b.size() > 0);
+	const int size = a.size() + b.size() - 1;
+	std::vector<long> product(size);
+	convolve(a.data(), a.size(), b.data(), b.size(), product.data(), a.getField());
+	GFVector result(a.getField(), size);
+	for(int i = 0; i < size; i++)
+	{
+		result.set(i, product[i]);
+	}
+	return result;
+}
+
+
+/**
+ * Returns the shared twiddle tables of this field, covering at least a given length
+ * @param logLength log of the transform length
+ * @return the tables
+ */
+const GFTransform::Twiddles* GFTransform::_twiddles(const int &logLength) const
+{
+	// tables only grow; replaced ones are kept, since other threads may still use them
+	static std::mutex cacheMutex;
+	static std::map<unsigned long, const Twiddles*> cache;
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	const Twiddles *&twiddles = cache[_p];
+	if(twiddles == nullptr || twiddles->logLength < logLength)
+	{
+		twiddles = _makeTwiddles(std::max(logLength, (twiddles == nullptr) ? 0 : twiddles->logLength));
+	}
+	return twiddles;
+}
+
+
+/**
+ * Builds the twiddle tables of this field for a given length
+ * @param logLength log of the transform length
+ * @return the tables
+ */
+GFTransform::Twiddles* GFTransform::_makeTwiddles(const int &logLength) const
+{
+	Twiddles *twiddles = new Twiddles;
+	twiddles->logLength = logLength;
+	const long length = std::max(1L << logLength, 4L);
+	twiddles->roots.assign(length, 0);
+	twiddles->inverseRoots.assign(length, 0);
+
+	const long p = (long)_p;
+	for(long h = 1; h < length; h *= 2)
+	{
+		// w_2h = maxRoot^(2^maxLog / 2h), which needs 2h <= 2^maxLog
+		if(__builtin_ctzl(2 * h) > _maxLog)
+		{
+			break;
+		}
+		const long root = GField::powMod((long)_maxRoot, 1L << (_maxLog - __builtin_ctzl(2 * h)), p);
+		const unsigned long step = _toMontgomery(root);
+		const unsigned long inverseStep = _toMontgomery(GField::powMod(root, p - 2, p));
+		unsigned long current = _toMontgomery(1), inverseCurrent = current;
+		for(long j = 0; j < h; j++)
+		{
+			twiddles->roots[h + j] = current;
+			twiddles->inverseRoots[h + j] = inverseCurrent;
+			current = montgomeryMultiply(current, step, _p, _pInverse);
+			inverseCurrent = montgomeryMultiply(inverseCurrent, inverseStep, _p, _pInverse);
+		}
+	}
+	return twiddles;
+}
+
+
+/**
+ * Inverse transform in place, with a caller chosen final scale
+ * @param values 2^logLength values
+ * @param logLength log of the length
+ * @param scale Montgomery form factor applied to every output
+ */
+void GFTransform::_inverse(long *values, const int &logLength, const unsigned long &scale) const
+{
+	assert(logLength >= 0 && logLength <= _maxLog);
+	const unsigned long *roots = _twiddles(logLength)->inverseRoots.data();
+	unsigned long *a = (unsigned long*)values;
+	const long length = 1L << logLength;
+	const long block = std::min(length, 1L << BLOCK_LOG);
+
+	long stages[64];
+	const int count = planStages(logLength, stages);
+	int i = count;
+	while(i > 0 && stageSpan(stages[i - 1]) <= block)
+	{
+		i--;
+	}
+	// the stages inside one block first, block by block, in the reverse order of forward
+	for(long start = 0; start < length; start += block)
+	{
+		for(int j = count - 1; j >= i; j--)
+		{
+			if(stages[j] > 0)
+			{
+				inverseRadix4(a + start, block, stages[j], roots, _p, _pInverse);
+			}
+			else
+			{
+				inverseRadix2(a + start, block, 1, roots, _p, _pInverse);
+			}
+		}
+	}
+	for(int j = i - 1; j >= 0; j--)
+	{
+		inverseRadix4(a, length, stages[j], roots, _p, _pInverse);
+	}
+	for(long k = 0; k < length; k++)
+	{
+		a[k] = montgomeryMultiply(a[k], scale, _p, _pInverse);
+	}
+}
+
+
+/**
+ * Returns a value in Montgomery form
+ * @param a a number in [0, p)
+ * @return a * 2^64 mod p
+ */
+unsigned long GFTransform::_toMontgomery(const unsigned long &a) const
+{
+	return montgomeryMultiply(a, _r2, _p, _pInverse);
+}
@@ -0,0 +1,160 @@
+#ifndef EX1_GFTRANSFORM_H
+#define EX1_GFTRANSFORM_H
+
+#include "GField.h"
+#include "GFVector.h"
+
+/**
+ * This class implements the number theoretic transform (NTT) over a prime field GF(p) with
+ * p = c * 2^k + 1 < 2^62, and the polynomial multiplication built on it.
+ * The forward transform is a decimation in frequency (natural order in, bit reversed order out)
+ * and the inverse a decimation in time (bit reversed in, natural out), so a convolution never
+ * permutes its data. Both run in place with radix-4 butterflies (plus one radix-2 stage for odd
+ * logs), over Montgomery form twiddles. Stages whose span fits a cache block are run block by
+ * block, so small spans never stream the whole array.
+ * Twiddle tables are built once per prime and shared by every transform of that field.
+ * Polynomials over any other prime field are multiplied with three transform primes and the
+ * Chinese remainder theorem.
+ */
+class GFTransform
+{
+
+public:
+
+	static const int BLOCK_LOG = 12;  // log of the number of values processed as one cache block
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Constructor
+	 * @param field a field GF(p) with p = c * 2^k + 1, k >= 1 and p < 2^62
+	 */
+	explicit GFTransform(const GField &field);
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Check if a field supports the transform
+	 * @param field a field
+	 * @return true if l = 1, p < 2^62 and p - 1 is even
+	 */
+	static bool isTransformField(const GField &field);
+
+	/**
+	 * Function returns the field of this transform
+	 * @return field of this transform
+	 */
+	const GField& getField() const;
+
+	/**
+	 * Returns the largest log of a transform length in this field
+	 * @return k, the power of 2 in p - 1
+	 */
+	const int& getMaxLog() const;
+
+	/**
+	 * Forward transform in place; the output is in bit reversed order
+	 * @param values 2^logLength reduced values of the field
+	 * @param logLength log of the length, at most getMaxLog()
+	 */
+	void forward(long *values, const int &logLength) const;
+
+	/**
+	 * Inverse transform in place, scaled by 1/2^logLength; the input is in bit reversed order
+	 * @param values 2^logLength reduced values of the field
+	 * @param logLength log of the length, at most getMaxLog()
+	 */
+	void inverse(long *values, const int &logLength) const;
+
+	/**
+	 * Multiplies two polynomials of this field
+	 * @param a coefficients of the first polynomial, constant term first
+	 * @param sizeA number of coefficients of a, at least 1
+	 * @param b coefficients of the second polynomial
+	 * @param sizeB number of coefficients of b, at least 1
+	 * @param result receives the sizeA + sizeB - 1 coefficients of the product; it may not
+	 *        overlap a or b
+	 */
+	void convolve(const long *a, const long &sizeA, const long *b, const long &sizeB,
+				  long *result) const;
+
+	/**
+	 * Multiplies two polynomials over any prime field, directly if the field supports a long
+	 * enough transform and with three transform primes and the CRT otherwise
+	 * @param a coefficients of the first polynomial, constant term first
+	 * @param sizeA number of coefficients of a, at least 1
+	 * @param b coefficients of the second polynomial
+	 * @param sizeB number of coefficients of b, at least 1
+	 * @param result receives the sizeA + sizeB - 1 coefficients of the product
+	 * @param field a field GF(p)
+	 */
+	static void convolve(const long *a, const long &sizeA, const long *b, const long &sizeB,
+						 long *result, const GField &field);
+
+	/**
+	 * Multiplies two polynomials given as vectors of coefficients of the same prime field
+	 * @param a coefficients of the first polynomial, constant term first
+	 * @param b coefficients of the second polynomial
+	 * @return the a.size() + b.size() - 1 coefficients of the product
+	 */
+	static GFVector multiply(const GFVector &a, const GFVector &b);
+
+
+private:
+
+	/**
+	 * Montgomery form roots of unity of one prime, for every stage up to some length
+	 */
+	struct Twiddles
+	{
+		int logLength;  // log of the longest transform the tables cover
+
+		std::vector<unsigned long> roots;  // roots[h + j] = w_2h^j, for h = 1, 2, 4, ...
+
+		std::vector<unsigned long> inverseRoots;  // inverseRoots[h + j] = w_2h^-j
+	};
+
+	GField _field;                  // the field of the transform
+
+	unsigned long _p;               // char of the field
+
+	unsigned long _pInverse;        // -p^-1 mod 2^64
+
+	unsigned long _r2;              // 2^128 mod p
+
+	int _maxLog;                    // power of 2 in p - 1
+
+	unsigned long _maxRoot;         // a primitive 2^maxLog-th root of unity
+
+	/**
+	 * Returns the shared twiddle tables of this field, covering at least a given length
+	 * @param logLength log of the transform length
+	 * @return the tables
+	 */
+	const Twiddles* _twiddles(const int &logLength) const;
+
+	/**
+	 * Builds the twiddle tables of this field for a given length
+	 * @param logLength log of the transform length
+	 * @return the tables
+	 */
+	Twiddles* _makeTwiddles(const int &logLength) const;
+
+	/**
+	 * Inverse transform in place, with a caller chosen final scale
+	 * @param values 2^logLength values
+	 * @param logLength log of the length
+	 * @param scale Montgomery form factor applied to every output
+	 */
+	void _inverse(long *values, const int &logLength, const unsigned long &scale) const;
+
+	/**
+	 * Returns a value in Montgomery form
+	 * @param a a number in [0, p)
+	 * @return a * 2^64 mod p
+	 */
+	unsigned long _toMontgomery(const unsigned long &a) const;
+};
+
+
+#endif //EX1_GFTRANSFORM_H
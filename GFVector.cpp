@@ -0,0 +1,679 @@
+#include "GFVector.h"
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+// alignment of the buffer of a vector, in bytes
+static const size_t ALIGNMENT = 64;
+
+// the vector kernels add two values without overflowing a signed 64 bit lane below this order
+static const long MAX_VECTOR_ADD_ORDER = 1L << 62;
+
+// the vector kernels multiply with 32 bit Montgomery reduction below this order
+static const long MAX_VECTOR_MULTIPLY_ORDER = 1L << 31;
+
+/**
+ * Instruction sets the vector kernels can use
+ */
+enum class SimdLevel
+{
+	SCALAR,
+	AVX2,
+	AVX512
+};
+
+/**
+ * Constants of Montgomery reduction with R = 2^32 for one odd modulus
+ */
+struct Montgomery32
+{
+	unsigned long modulus;  // the modulus m
+	unsigned long inverse;  // -m^-1 mod 2^32
+	unsigned long r2;       // 2^64 mod m
+};
+
+
+/**
+ * Returns the best instruction set of this CPU, detected once with CPUID
+ * @return the instruction set used by the kernels
+ */
+static SimdLevel simdLevel()
+{
+#if defined(__x86_64__)
+	static const SimdLevel level = __builtin_cpu_supports("avx512f") ? SimdLevel::AVX512 :
+								   __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 :
+								   SimdLevel::SCALAR;
+	return level;
+#else
+	return SimdLevel::SCALAR;
+#endif
+}
+
+
+/**
+ * Computes the 32 bit Montgomery constants of an odd modulus
+ * @param m an odd modulus below 2^31
+ * @return the constants
+ */
+static Montgomery32 montgomery32(const long &m)
+{
+	unsigned long inverse = (unsigned long)m;
+	for(int i = 0; i < 5; i++)
+	{
+		inverse *= 2 - (unsigned long)m * inverse;
+	}
+	unsigned long r2 = (unsigned long)(((unsigned __int128)1 << 64) % (unsigned long)m);
+	return Montgomery32{(unsigned long)m, (0UL - inverse) & 0xFFFFFFFFUL, r2};
+}
+
+
+/**
+ * Check if the addition kernels can run on a field
+ * @param field a field
+ * @return true if the field is a prime field small enough for the vector kernels
+ */
+static bool canVectorizeAddition(const GField &field)
+{
+	return field.getDegree() == 1 && field.getOrder() < MAX_VECTOR_ADD_ORDER;
+}
+
+
+/**
+ * Check if the multiplication kernels can run on a field
+ * @param field a field
+ * @return true if the field is GF(p) with an odd p small enough for 32 bit Montgomery reduction
+ */
+static bool canVectorizeMultiplication(const GField &field)
+{
+	return field.hasMontgomery() && field.getOrder() < MAX_VECTOR_MULTIPLY_ORDER;
+}
+
+
+#if defined(__x86_64__)
+
+///////////////////////////////////////////   AVX2   //////////////////////////////////////////////
+
+/**
+ * Subtracts m from every lane which is not smaller than m
+ * @param x lanes in [0, 2m) with 2m < 2^63
+ * @param m the modulus in every lane
+ * @return x mod m
+ */
+__attribute__((target("avx2")))
+static inline __m256i reduceOnceAvx2(const __m256i &x, const __m256i &m)
+{
+	return _mm256_sub_epi64(x, _mm256_andnot_si256(_mm256_cmpgt_epi64(m, x), m));
+}
+
+
+/**
+ * Montgomery reduction with R = 2^32 of every lane
+ * @param t lanes smaller than m * 2^32
+ * @param m the modulus in every lane
+ * @param inverse -m^-1 mod 2^32 in every lane
+ * @return t * 2^-32 mod m
+ */
+__attribute__((target("avx2")))
+static inline __m256i montgomeryReduceAvx2(const __m256i &t, const __m256i &m, const __m256i &inverse)
+{
+	__m256i q = _mm256_mul_epu32(t, inverse);
+	__m256i sum = _mm256_add_epi64(t, _mm256_mul_epu32(q, m));
+	return reduceOnceAvx2(_mm256_srli_epi64(sum, 32), m);
+}
+
+
+/**
+ * Multiplies every lane modulo m with two Montgomery reductions
+ * @param a lanes in [0, m)
+ * @param b lanes in [0, m)
+ * @param m the modulus in every lane
+ * @param inverse -m^-1 mod 2^32 in every lane
+ * @param r2 2^64 mod m in every lane
+ * @return a * b mod m
+ */
+__attribute__((target("avx2")))
+static inline __m256i multiplyAvx2(const __m256i &a, const __m256i &b, const __m256i &m,
+								   const __m256i &inverse, const __m256i &r2)
+{
+	__m256i t = montgomeryReduceAvx2(_mm256_mul_epu32(a, b), m, inverse);
+	return montgomeryReduceAvx2(_mm256_mul_epu32(t, r2), m, inverse);
+}
+
+
+/**
+ * Element-wise modular addition
+ * @param out output values
+ * @param a input values
+ * @param b input values
+ * @param size number of values
+ * @param modulus the modulus
+ * @return number of values processed; the remaining tail is left to the caller
+ */
+__attribute__((target("avx2")))
+static int addAvx2(long *out, const long *a, const long *b, const int &size, const long &modulus)
+{
+	const __m256i m = _mm256_set1_epi64x(modulus);
+	int i = 0;
+	for(; i + 4 <= size; i += 4)
+	{
+		__m256i x = _mm256_load_si256((const __m256i*)(a + i));
+		__m256i y = _mm256_load_si256((const __m256i*)(b + i));
+		_mm256_store_si256((__m256i*)(out + i), reduceOnceAvx2(_mm256_add_epi64(x, y), m));
+	}
+	return i;
+}
+
+
+/**
+ * Element-wise modular subtraction
+ * @param out output values
+ * @param a input values
+ * @param b input values
+ * @param size number of values
+ * @param modulus the modulus
+ * @return number of values processed; the remaining tail is left to the caller
+ */
+__attribute__((target("avx2")))
+static int subtractAvx2(long *out, const long *a, const long *b, const int &size,
+						const long &modulus)
+{
+	const __m256i m = _mm256_set1_epi64x(modulus);
+	int i = 0;
+	for(; i + 4 <= size; i += 4)
+	{
+		__m256i x = _mm256_load_si256((const __m256i*)(a + i));
+		__m256i y = _mm256_load_si256((const __m256i*)(b + i));
+		__m256i borrow = _mm256_and_si256(_mm256_cmpgt_epi64(y, x), m);
+		_mm256_store_si256((__m256i*)(out + i), _mm256_add_epi64(_mm256_sub_epi64(x, y), borrow));
+	}
+	return i;
+}
+
+
+/**
+ * Element-wise modular multiplication, optionally followed by an addition
+ * @param out output values
+ * @param a input values
+ * @param b input values
+ * @param c values added to the products, or null
+ * @param size number of values
+ * @param constants Montgomery constants of the modulus
+ * @return number of values processed; the remaining tail is left to the caller
+ */
+__attribute__((target("avx2")))
+static int multiplyAddAvx2(long *out, const long *a, const long *b, const long *c, const int &size,
+						   const Montgomery32 &constants)
+{
+	const __m256i m = _mm256_set1_epi64x((long)constants.modulus);
+	const __m256i inverse = _mm256_set1_epi64x((long)constants.inverse);
+	const __m256i r2 = _mm256_set1_epi64x((long)constants.r2);
+	int i = 0;
+	for(; i + 4 <= size; i += 4)
+	{
+		__m256i x = _mm256_load_si256((const __m256i*)(a + i));
+		__m256i y = _mm256_load_si256((const __m256i*)(b + i));
+		__m256i product = multiplyAvx2(x, y, m, inverse, r2);
+		if(c != nullptr)
+		{
+			__m256i z = _mm256_load_si256((const __m256i*)(c + i));
+			product = reduceOnceAvx2(_mm256_add_epi64(product, z), m);
+		}
+		_mm256_store_si256((__m256i*)(out + i), product);
+	}
+	return i;
+}
+
+
+//////////////////////////////////////////   AVX-512   ////////////////////////////////////////////
+
+// GCC 12 reports the intentionally undefined operands inside avx512fintrin.h (GCC bug 105593)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/**
+ * Subtracts m from every lane which is not smaller than m
+ * @param x lanes in [0, 2m)
+ * @param m the modulus in every lane
+ * @return x mod m
+ */
+__attribute__((target("avx512f")))
+static inline __m512i reduceOnceAvx512(const __m512i &x, const __m512i &m)
+{
+	return _mm512_min_epu64(x, _mm512_sub_epi64(x, m));
+}
+
+
+/**
+ * Montgomery reduction with R = 2^32 of every lane
+ * @param t lanes smaller than m * 2^32
+ * @param m the modulus in every lane
+ * @param inverse -m^-1 mod 2^32 in every lane
+ * @return t * 2^-32 mod m
+ */
+__attribute__((target("avx512f")))
+static inline __m512i montgomeryReduceAvx512(const __m512i &t, const __m512i &m,
+											 const __m512i &inverse)
+{
+	__m512i q = _mm512_mul_epu32(t, inverse);
+	__m512i sum = _mm512_add_epi64(t, _mm512_mul_epu32(q, m));
+	return reduceOnceAvx512(_mm512_srli_epi64(sum, 32), m);
+}
+
+
+/**
+ * Element-wise modular addition
+ * @param out output values
+ * @param a input values
+ * @param b input values
+ * @param size number of values
+ * @param modulus the modulus
+ * @return number of values processed; the remaining tail is left to the caller
+ */
+__attribute__((target("avx512f")))
+static int addAvx512(long *out, const long *a, const long *b, const int &size,
+					 const long &modulus)
+{
+	const __m512i m = _mm512_set1_epi64(modulus);
+	int i = 0;
+	for(; i + 8 <= size; i += 8)
+	{
+		__m512i x = _mm512_load_si512(a + i);
+		__m512i y = _mm512_load_si512(b + i);
+		_mm512_store_si512(out + i, reduceOnceAvx512(_mm512_add_epi64(x, y), m));
+	}
+	return i;
+}
+
+
+/**
+ * Element-wise modular subtraction
+ * @param out output values
+ * @param a input values
+ * @param b input values
+ * @param size number of values
+ * @param modulus the modulus
+ * @return number of values processed; the remaining tail is left to the caller
+ */
+__attribute__((target("avx512f")))
+static int subtractAvx512(long *out, const long *a, const long *b, const int &size,
+						  const long &modulus)
+{
+	const __m512i m = _mm512_set1_epi64(modulus);
+	int i = 0;
+	for(; i + 8 <= size; i += 8)
+	{
+		__m512i x = _mm512_load_si512(a + i);
+		__m512i y = _mm512_load_si512(b + i);
+		__m512i difference = _mm512_sub_epi64(x, y);
+		_mm512_store_si512(out + i, _mm512_min_epu64(difference, _mm512_add_epi64(difference, m)));
+	}
+	return i;
+}
+
+
+/**
+ * Element-wise modular multiplication, optionally followed by an addition
+ * @param out output values
+ * @param a input values
+ * @param b input values
+ * @param c values added to the products, or null
+ * @param size number of values
+ * @param constants Montgomery constants of the modulus
+ * @return number of values processed; the remaining tail is left to the caller
+ */
+__attribute__((target("avx512f")))
+static int multiplyAddAvx512(long *out, const long *a, const long *b, const long *c,
+							 const int &size, const Montgomery32 &constants)
+{
+	const __m512i m = _mm512_set1_epi64((long)constants.modulus);
+	const __m512i inverse = _mm512_set1_epi64((long)constants.inverse);
+	const __m512i r2 = _mm512_set1_epi64((long)constants.r2);
+	int i = 0;
+	for(; i + 8 <= size; i += 8)
+	{
+		__m512i x = _mm512_load_si512(a + i);
+		__m512i y = _mm512_load_si512(b + i);
+		__m512i t = montgomeryReduceAvx512(_mm512_mul_epu32(x, y), m, inverse);
+		__m512i product = montgomeryReduceAvx512(_mm512_mul_epu32(t, r2), m, inverse);
+		if(c != nullptr)
+		{
+			__m512i z = _mm512_load_si512(c + i);
+			product = reduceOnceAvx512(_mm512_add_epi64(product, z), m);
+		}
+		_mm512_store_si512(out + i, product);
+	}
+	return i;
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Default constructor - an empty vector over GF(2**1)
+ */
+GFVector::GFVector():_gField(), _residues(nullptr), _size(0)
+{
+
+}
+
+
+/**
+ * Constructor #1 - a vector of zeros
+ * @param field the field of the numbers
+ * @param size number of numbers
+ */
+GFVector::GFVector(const GField &field, const int &size):_gField(field), _size(size)
+{
+	assert(size >= 0);
+	_residues = _allocate(size);
+	memset(_residues, 0, sizeof(long) * size);
+}
+
+
+/**
+ * Constructor #2 - copies an array of numbers of one field
+ * @param numbers numbers of the same field
+ * @param size number of numbers, at least 1
+ */
+GFVector::GFVector(const GFNumber *numbers, const int &size):_gField(numbers[0].getField()),
+															 _size(size)
+{
+	_residues = _allocate(size);
+	for(int i = 0; i < size; i++)
+	{
+		assert(numbers[i].getField().getOrder() == _gField.getOrder());
+		_residues[i] = numbers[i].getNumber();
+	}
+}
+
+
+/**
+ * Copy constructor
+ * @param other another vector
+ */
+GFVector::GFVector(const GFVector &other):_gField(other._gField), _size(other._size)
+{
+	_residues = _allocate(_size);
+	memcpy(_residues, other._residues, sizeof(long) * _size);
+}
+
+
+/**
+ * Destructor
+ */
+GFVector::~GFVector()
+{
+	free(_residues);
+}
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Returns the number of numbers in this vector
+ * @return size of the vector
+ */
+int GFVector::size() const
+{
+	return _size;
+}
+
+
+/**
+ * Function returns the field of the numbers of this vector
+ * @return field of this vector
+ */
+const GField& GFVector::getField() const
+{
+	return _gField;
+}
+
+
+/**
+ * Returns the reduced value at a position
+ * @param i an index in [0, size())
+ * @return the value at position i
+ */
+const long& GFVector::get(const int &i) const
+{
+	assert(i >= 0 && i < _size);
+	return _residues[i];
+}
+
+
+/**
+ * Sets the value at a position
+ * @param i an index in [0, size())
+ * @param value any number, reduced into the field
+ */
+void GFVector::set(const int &i, const long &value)
+{
+	assert(i >= 0 && i < _size);
+	_residues[i] = _gField.reduce(value);
+}
+
+
+/**
+ * Returns the number at a position
+ * @param i an index in [0, size())
+ * @return the number at position i
+ */
+GFNumber GFVector::getNumber(const int &i) const
+{
+	return GFNumber(get(i), _gField);
+}
+
+
+/**
+ * Returns the buffer of reduced values
+ * @return pointer to the first value
+ */
+const long* GFVector::data() const
+{
+	return _residues;
+}
+
+
+/**
+ * Sets this vector to the element-wise sum of two vectors of its field and size
+ * @param a a vector
+ * @param b a vector
+ */
+void GFVector::add(const GFVector &a, const GFVector &b)
+{
+	assert(a._size == _size && b._size == _size);
+	assert(a._gField.getOrder() == getField().getOrder() && b._gField.getOrder() == getField().getOrder());
+	int done = 0;
+#if defined(__x86_64__)
+	if(canVectorizeAddition(_gField))
+	{
+		switch(simdLevel())
+		{
+			case SimdLevel::AVX512:
+				done = addAvx512(_residues, a._residues, b._residues, _size, _gField.getOrder());
+				break;
+			case SimdLevel::AVX2:
+				done = addAvx2(_residues, a._residues, b._residues, _size, _gField.getOrder());
+				break;
+			default:
+				break;
+		}
+	}
+#endif
+	for(int i = done; i < _size; i++)
+	{
+		_residues[i] = _gField.add(a._residues[i], b._residues[i]);
+	}
+}
+
+
+/**
+ * Sets this vector to the element-wise difference of two vectors of its field and size
+ * @param a a vector
+ * @param b a vector
+ */
+void GFVector::subtract(const GFVector &a, const GFVector &b)
+{
+	assert(a._size == _size && b._size == _size);
+	assert(a._gField.getOrder() == getField().getOrder() && b._gField.getOrder() == getField().getOrder());
+	int done = 0;
+#if defined(__x86_64__)
+	if(canVectorizeAddition(_gField))
+	{
+		switch(simdLevel())
+		{
+			case SimdLevel::AVX512:
+				done = subtractAvx512(_residues, a._residues, b._residues, _size, _gField.getOrder());
+				break;
+			case SimdLevel::AVX2:
+				done = subtractAvx2(_residues, a._residues, b._residues, _size, _gField.getOrder());
+				break;
+			default:
+				break;
+		}
+	}
+#endif
+	for(int i = done; i < _size; i++)
+	{
+		_residues[i] = _gField.subtract(a._residues[i], b._residues[i]);
+	}
+}
+
+
+/**
+ * Sets this vector to the element-wise product of two vectors of its field and size
+ * @param a a vector
+ * @param b a vector
+ */
+void GFVector::multiply(const GFVector &a, const GFVector &b)
+{
+	assert(a._size == _size && b._size == _size);
+	assert(a._gField.getOrder() == getField().getOrder() && b._gField.getOrder() == getField().getOrder());
+	int done = 0;
+#if defined(__x86_64__)
+	if(canVectorizeMultiplication(_gField) && simdLevel() != SimdLevel::SCALAR)
+	{
+		const Montgomery32 constants = montgomery32(_gField.getOrder());
+		done = (simdLevel() == SimdLevel::AVX512) ?
+			   multiplyAddAvx512(_residues, a._residues, b._residues, nullptr, _size, constants) :
+			   multiplyAddAvx2(_residues, a._residues, b._residues, nullptr, _size, constants);
+	}
+#endif
+	for(int i = done; i < _size; i++)
+	{
+		_residues[i] = _gField.multiply(a._residues[i], b._residues[i]);
+	}
+}
+
+
+/**
+ * Sets this vector to a * b + c element-wise, for vectors of its field and size
+ * @param a a vector
+ * @param b a vector
+ * @param c a vector
+ */
+void GFVector::multiplyAdd(const GFVector &a, const GFVector &b, const GFVector &c)
+{
+	assert(a._size == _size && b._size == _size && c._size == _size);
+	assert(a._gField.getOrder() == getField().getOrder() && b._gField.getOrder() == getField().getOrder() &&
+		   c._gField.getOrder() == getField().getOrder());
+	int done = 0;
+#if defined(__x86_64__)
+	if(canVectorizeMultiplication(_gField) && simdLevel() != SimdLevel::SCALAR)
+	{
+		const Montgomery32 constants = montgomery32(_gField.getOrder());
+		done = (simdLevel() == SimdLevel::AVX512) ?
+			   multiplyAddAvx512(_residues, a._residues, b._residues, c._residues, _size, constants) :
+			   multiplyAddAvx2(_residues, a._residues, b._residues, c._residues, _size, constants);
+	}
+#endif
+	for(int i = done; i < _size; i++)
+	{
+		_residues[i] = _gField.add(_gField.multiply(a._residues[i], b._residues[i]), c._residues[i]);
+	}
+}
+
+
+/**
+ * Allocates an aligned buffer for size values
+ * @param size number of values
+ * @return the buffer
+ */
+long* GFVector::_allocate(const int &size)
+{
+	// aligned_alloc needs a multiple of the alignment, and never returns null for a zero size
+	size_t bytes = (sizeof(long) * size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	long *buffer = (long*)aligned_alloc(ALIGNMENT, (bytes == 0) ? ALIGNMENT : bytes);
+	assert(buffer != nullptr);
+	return buffer;
+}
+
+
+
+////////////////////////////////////////   Operators    ///////////////////////////////////////
+
+/**
+ * Overload '=' operator to place one GFVector into another
+ * @param other The GFVector object to be placed in this object
+ * @return A reference to this object after the other vector was placed into it
+ */
+GFVector& GFVector::operator=(const GFVector &other)
+{
+	if(this == &other)
+	{
+		return *this;
+	}
+	if(_size != other._size)
+	{
+		free(_residues);
+		_residues = _allocate(other._size);
+		_size = other._size;
+	}
+	_gField = other._gField;
+	memcpy(_residues, other._residues, sizeof(long) * _size);
+	return *this;
+}
+
+
+/**
+ * Overload '+=' operator to add a vector element-wise to this vector
+ * @param other a vector of the same field and size
+ * @return This vector after the addition
+ */
+GFVector& GFVector::operator+=(const GFVector &other)
+{
+	add(*this, other);
+	return *this;
+}
+
+
+/**
+ * Overload '-=' operator to subtract a vector element-wise from this vector
+ * @param other a vector of the same field and size
+ * @return This vector after the subtraction
+ */
+GFVector& GFVector::operator-=(const GFVector &other)
+{
+	subtract(*this, other);
+	return *this;
+}
+
+
+/**
+ * Overload '*=' operator to multiply this vector element-wise by another vector
+ * @param other a vector of the same field and size
+ * @return This vector after the multiplication
+ */
+GFVector& GFVector::operator*=(const GFVector &other)
+{
+	multiply(*this, other);
+	return *this;
+}
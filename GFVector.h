@@ -0,0 +1,169 @@
+#ifndef EX1_GFVECTOR_H
+#define EX1_GFVECTOR_H
+
+#include "GField.h"
+#include "GFNumber.h"
+
+/**
+ * This class represents a vector of numbers of one field, stored as a contiguous, 64 byte
+ * aligned buffer of reduced values with a single shared field.
+ * Element-wise operations run AVX-512 or AVX2 kernels when the CPU has them and the field is a
+ * small enough prime field, and a scalar loop over the field operations otherwise.
+ */
+class GFVector
+{
+
+public:
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Default constructor - an empty vector over GF(2**1)
+	 */
+	GFVector();
+
+	/**
+	 * Constructor #1 - a vector of zeros
+	 * @param field the field of the numbers
+	 * @param size number of numbers
+	 */
+	GFVector(const GField &field, const int &size);
+
+	/**
+	 * Constructor #2 - copies an array of numbers of one field
+	 * @param numbers numbers of the same field
+	 * @param size number of numbers, at least 1
+	 */
+	GFVector(const GFNumber *numbers, const int &size);
+
+	/**
+	 * Copy constructor
+	 * @param other another vector
+	 */
+	GFVector(const GFVector &other);
+
+	/**
+	 * Destructor
+	 */
+	~GFVector();
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Returns the number of numbers in this vector
+	 * @return size of the vector
+	 */
+	int size() const;
+
+	/**
+	 * Function returns the field of the numbers of this vector
+	 * @return field of this vector
+	 */
+	const GField& getField() const;
+
+	/**
+	 * Returns the reduced value at a position
+	 * @param i an index in [0, size())
+	 * @return the value at position i
+	 */
+	const long& get(const int &i) const;
+
+	/**
+	 * Sets the value at a position
+	 * @param i an index in [0, size())
+	 * @param value any number, reduced into the field
+	 */
+	void set(const int &i, const long &value);
+
+	/**
+	 * Returns the number at a position
+	 * @param i an index in [0, size())
+	 * @return the number at position i
+	 */
+	GFNumber getNumber(const int &i) const;
+
+	/**
+	 * Returns the buffer of reduced values
+	 * @return pointer to the first value
+	 */
+	const long* data() const;
+
+	/**
+	 * Sets this vector to the element-wise sum of two vectors of its field and size
+	 * @param a a vector
+	 * @param b a vector
+	 */
+	void add(const GFVector &a, const GFVector &b);
+
+	/**
+	 * Sets this vector to the element-wise difference of two vectors of its field and size
+	 * @param a a vector
+	 * @param b a vector
+	 */
+	void subtract(const GFVector &a, const GFVector &b);
+
+	/**
+	 * Sets this vector to the element-wise product of two vectors of its field and size
+	 * @param a a vector
+	 * @param b a vector
+	 */
+	void multiply(const GFVector &a, const GFVector &b);
+
+	/**
+	 * Sets this vector to a * b + c element-wise, for vectors of its field and size
+	 * @param a a vector
+	 * @param b a vector
+	 * @param c a vector
+	 */
+	void multiplyAdd(const GFVector &a, const GFVector &b, const GFVector &c);
+
+
+	///////////////////////////////////   Operators   /////////////////////////////////////////////
+
+	/**
+	 * Overload '=' operator to place one GFVector into another
+	 * @param other The GFVector object to be placed in this object
+	 * @return A reference to this object after the other vector was placed into it
+	 */
+	GFVector& operator=(const GFVector &other);
+
+	/**
+	 * Overload '+=' operator to add a vector element-wise to this vector
+	 * @param other a vector of the same field and size
+	 * @return This vector after the addition
+	 */
+	GFVector& operator+=(const GFVector &other);
+
+	/**
+	 * Overload '-=' operator to subtract a vector element-wise from this vector
+	 * @param other a vector of the same field and size
+	 * @return This vector after the subtraction
+	 */
+	GFVector& operator-=(const GFVector &other);
+
+	/**
+	 * Overload '*=' operator to multiply this vector element-wise by another vector
+	 * @param other a vector of the same field and size
+	 * @return This vector after the multiplication
+	 */
+	GFVector& operator*=(const GFVector &other);
+
+
+private:
+
+	GField _gField;    // the field of the numbers
+
+	long *_residues;   // 64 byte aligned reduced values
+
+	int _size;         // number of numbers
+
+	/**
+	 * Allocates an aligned buffer for size values
+	 * @param size number of values
+	 * @return the buffer
+	 */
+	static long* _allocate(const int &size);
+};
+
+
+#endif //EX1_GFVECTOR_H
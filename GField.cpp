@@ -1,12 +1,134 @@
 #include "GField.h"
 #include "GFNumber.h"
+#include "GFExtension.h"
+#include "GFBinary.h"
+#include "GFLogTable.h"
+#include "FactorStats.h"
+#include "PrimeSieve.h"
+#include <climits>
+
+// number of small primes, from 2 up, used to filter candidates before running Miller-Rabin
+static const int FILTER_PRIMES = 25;
+
+// witnesses which make Miller-Rabin deterministic for every n < 2^64 (Sinclair)
+static const long MILLER_RABIN_WITNESSES[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+
+// largest window used by sliding window exponentiation
+static const int MAX_WINDOW = 5;
+
+// memory all log tables together may take; 0 disables them
+static std::atomic<size_t> logTableBudget(0);
+
+// memory taken or reserved by the log tables built so far
+static std::atomic<size_t> logTableBytes(0);
+
+
+/**
+ * Left-to-right sliding window exponentiation over any multiplication
+ * @param a the base
+ * @param one the identity of the multiplication
+ * @param exponent a non negative exponent
+ * @param mul the multiplication
+ * @return a^exponent
+ */
+template<typename Multiply>
+static long slidingWindowPower(const long& a, const long& one, const long& exponent, Multiply mul)
+{
+	if(exponent == 0)
+	{
+		return one;
+	}
+	const int topBit = 63 - __builtin_clzl(exponent);
+	const int window = (topBit >= 48) ? 5 : (topBit >= 24) ? 4 : (topBit >= 8) ? 3 : 1;
+
+	// oddPowers[i] = a^(2i + 1)
+	long oddPowers[1 << (MAX_WINDOW - 1)];
+	oddPowers[0] = a;
+	if(window > 1)
+	{
+		const long square = mul(a, a);
+		for(int i = 1; i < (1 << (window - 1)); i++)
+		{
+			oddPowers[i] = mul(oddPowers[i - 1], square);
+		}
+	}
+
+	long result = one;
+	bool started = false;
+	int i = topBit;
+	while(i >= 0)
+	{
+		if(((exponent >> i) & 1) == 0)
+		{
+			if(started)
+			{
+				result = mul(result, result);
+			}
+			i--;
+			continue;
+		}
+		// the longest odd run of at most window bits starting at bit i
+		int j = (i - window + 1 > 0) ? i - window + 1 : 0;
+		while(((exponent >> j) & 1) == 0)
+		{
+			j++;
+		}
+		const long bits = (exponent >> j) & ((1L << (i - j + 1)) - 1);
+		if(started)
+		{
+			for(int k = j; k <= i; k++)
+			{
+				result = mul(result, result);
+			}
+			result = mul(result, oddPowers[bits >> 1]);
+		}
+		else
+		{
+			result = oddPowers[bits >> 1];
+			started = true;
+		}
+		i = j - 1;
+	}
+	return result;
+}
+
+
+/**
+ * Montgomery ladder exponentiation over any multiplication
+ * @param a the base
+ * @param one the identity of the multiplication
+ * @param exponent a non negative exponent
+ * @param mul the multiplication
+ * @return a^exponent
+ */
+template<typename Multiply>
+static long ladderPower(const long& a, const long& one, const long& exponent, Multiply mul)
+{
+	long low = one, high = a;
+	for(int i = 62; i >= 0; i--)
+	{
+		// swap through a mask instead of branching on the exponent bit
+		const long mask = -((exponent >> i) & 1);
+		long swap = (low ^ high) & mask;
+		low ^= swap;
+		high ^= swap;
+
+		high = mul(low, high);
+		low = mul(low, low);
+
+		swap = (low ^ high) & mask;
+		low ^= swap;
+		high ^= swap;
+	}
+	return low;
+}
 
 ////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
 
 /**
  * Default constructor
  */
-GField::GField():_p(2), _l(1)
+GField::GField():_descriptor(_intern(2, 1))
 {
 
 }
@@ -16,16 +138,9 @@ GField::GField():_p(2), _l(1)
  * Constructor #1
  * @param p the p value of this field
  */
-GField::GField(long p)
+GField::GField(long p):_descriptor(_intern(p, 1))
 {
-	assert(p != 0);
-	if(p < 0)
-	{
-		p *= (-1);
-	}
-	assert(GField::isPrime(p));
-	_p = p;
-	_l = 1;
+
 }
 
 
@@ -34,16 +149,9 @@ GField::GField(long p)
  * @param p p value of the field
  * @param l l value of the field
  */
-GField::GField(long p, const long& l)
+GField::GField(long p, const long& l):_descriptor(_intern(p, l))
 {
-	assert(p != 0);
-	if(p < 0)
-	{
-		p *= (-1);
-	}
-	assert(GField::isPrime(p) && l > 0);
-	_p = p;
-	_l = l;
+
 }
 
 
@@ -51,16 +159,9 @@ GField::GField(long p, const long& l)
  * Copy constructor
  * @param other another field
  */
-GField::GField(const GField &other)
+GField::GField(const GField &other):_descriptor(other._descriptor)
 {
-	long p = other._p;
-	if(p < 0)
-	{
-		p *= (-1);
-	}
-	assert(GField::isPrime(p) && other._l > 0);
-	_p = p;
-	_l = other._l;
+
 }
 
 
@@ -83,7 +184,7 @@ GField::~GField()
  */
 const long& GField::getChar() const
 {
-	return _p;
+	return _descriptor->p;
 }
 
 /**
@@ -92,7 +193,7 @@ const long& GField::getChar() const
  */
 const long& GField::getDegree() const
 {
-	return _l;
+	return _descriptor->l;
 }
 
 /**
@@ -101,8 +202,7 @@ const long& GField::getDegree() const
  */
 void GField::setChar(const long& p)
 {
-	assert(isPrime(p));
-	_p = p;
+	_descriptor = _intern(p, _descriptor->l);
 }
 
 
@@ -112,8 +212,7 @@ void GField::setChar(const long& p)
  */
 void GField::setDegree(const long& l)
 {
-	assert(l > 0);
-	_l = l;
+	_descriptor = _intern(_descriptor->p, l);
 }
 
 
@@ -123,38 +222,517 @@ void GField::setDegree(const long& l)
  */
 const long GField::getOrder() const
 {
-	return (long)pow(_p, _l);
+	return _descriptor->order;
 }
 
 
 /**
- * Check if the number p is a prime number
- * @param p the number
- * @return true if the number is a prime number
+ * Reduces any number into the range [0, order) of this field; a negative k is the additive
+ * inverse of the element of -k, which only in prime fields is order - (-k mod order)
+ * @param k a number
+ * @return the element of k
  */
-bool GField::isPrime(const long& p)
+long GField::reduce(const long& k) const
+{
+	if(k >= 0)
+	{
+		return (k < _descriptor->order) ? k : _barrettReduce((unsigned long)k);
+	}
+	long r = _barrettReduce(0UL - (unsigned long)k);
+	if(_descriptor->extension != nullptr || _descriptor->binary != nullptr)
+	{
+		return subtract(0, r);
+	}
+	return (r == 0) ? 0 : _descriptor->order - r;
+}
+
+
+/**
+ * Adds two reduced values of this field
+ * @param a a number in [0, order)
+ * @param b a number in [0, order)
+ * @return a + b in this field
+ */
+long GField::add(const long& a, const long& b) const
+{
+	if(_descriptor->binary != nullptr)
+	{
+		return a ^ b;
+	}
+	if(_descriptor->extension != nullptr)
+	{
+		return _descriptor->extension->add(a, b);
+	}
+	unsigned long sum = (unsigned long)a + (unsigned long)b;
+	if(sum >= (unsigned long)_descriptor->order)
+	{
+		sum -= _descriptor->order;
+	}
+	return (long)sum;
+}
+
+
+/**
+ * Subtracts two reduced values of this field
+ * @param a a number in [0, order)
+ * @param b a number in [0, order)
+ * @return a - b in this field
+ */
+long GField::subtract(const long& a, const long& b) const
+{
+	if(_descriptor->binary != nullptr)
+	{
+		return a ^ b;
+	}
+	if(_descriptor->extension != nullptr)
+	{
+		return _descriptor->extension->subtract(a, b);
+	}
+	long difference = a - b;
+	if(difference < 0)
+	{
+		difference += _descriptor->order;
+	}
+	return difference;
+}
+
+
+/**
+ * Multiplies two reduced values of this field
+ * @param a a number in [0, order)
+ * @param b a number in [0, order)
+ * @return a * b in this field
+ */
+long GField::multiply(const long& a, const long& b) const
+{
+	if(const GFLogTable *table = getLogTable())
+	{
+		return table->multiply(a, b);
+	}
+	return _multiplyDirect(a, b);
+}
+
+
+/**
+ * Multiplies two reduced values of this field without the log tables
+ * @param a a number in [0, order)
+ * @param b a number in [0, order)
+ * @return a * b in this field
+ */
+long GField::_multiplyDirect(const long& a, const long& b) const
+{
+	if(_descriptor->binary != nullptr)
+	{
+		return (long)_descriptor->binary->multiply((unsigned long)a, (unsigned long)b);
+	}
+	if(_descriptor->extension != nullptr)
+	{
+		return _descriptor->extension->multiply(a, b);
+	}
+	return _barrettReduce((unsigned __int128)a * (unsigned long)b);
+}
+
+
+/**
+ * Raises a reduced value of this field to a power, using left-to-right sliding window
+ * exponentiation over Montgomery form in odd prime fields
+ * @param a a number in [0, order)
+ * @param exponent a non negative exponent
+ * @return a^exponent in this field
+ */
+long GField::power(const long& a, const long& exponent) const
+{
+	assert(exponent >= 0);
+	if(const GFLogTable *table = getLogTable())
+	{
+		return table->power(a, exponent);
+	}
+	if(hasMontgomery())
+	{
+		long result = slidingWindowPower(toMontgomery(a), toMontgomery(reduce(1)), exponent,
+										 [this](const long& x, const long& y)
+										 { return montgomeryMultiply(x, y); });
+		return fromMontgomery(result);
+	}
+	return slidingWindowPower(a, reduce(1), exponent,
+							  [this](const long& x, const long& y) { return multiply(x, y); });
+}
+
+
+/**
+ * Raises a reduced value of this field to a power with a Montgomery ladder, which runs one
+ * squaring and one multiplication for every bit of the exponent whatever its value
+ * @param a a number in [0, order)
+ * @param exponent a non negative exponent
+ * @return a^exponent in this field
+ */
+long GField::powerLadder(const long& a, const long& exponent) const
+{
+	assert(exponent >= 0);
+	if(hasMontgomery())
+	{
+		long result = ladderPower(toMontgomery(a), toMontgomery(reduce(1)), exponent,
+								  [this](const long& x, const long& y)
+								  { return montgomeryMultiply(x, y); });
+		return fromMontgomery(result);
+	}
+	return ladderPower(a, reduce(1), exponent,
+					   [this](const long& x, const long& y) { return multiply(x, y); });
+}
+
+
+/**
+ * Check if Montgomery arithmetic is available in this field, which requires a prime field
+ * GF(p) with an odd p
+ * @return true if l = 1 and p is odd
+ */
+bool GField::hasMontgomery() const
+{
+	return _descriptor->extension == nullptr && _descriptor->binary == nullptr &&
+		   (_descriptor->order & 1) != 0;
+}
+
+
+/**
+ * Returns the log/antilog/Zech tables of this field, building them the first time they are
+ * asked for. Only fields with order <= 65536 get tables, and only while the memory budget
+ * allows it; the tables are then used by multiply, inverse and power.
+ * @return the tables, or null if this field has none
+ */
+const GFLogTable* GField::getLogTable() const
+{
+	LogTableSlot *slot = _descriptor->logTables;
+	if(slot == nullptr)
+	{
+		return nullptr;
+	}
+	const GFLogTable *table = slot->table.load(std::memory_order_acquire);
+	if(table != nullptr || logTableBudget.load(std::memory_order_relaxed) == 0)
+	{
+		return table;
+	}
+	// reserve the memory before committing the field to its single construction attempt, so a
+	// field which does not fit now can still get tables after the budget grows
+	const size_t bytes = GFLogTable::bytesFor(_descriptor->order);
+	size_t used = logTableBytes.load();
+	do
+	{
+		if(used + bytes > logTableBudget.load())
+		{
+			return nullptr;
+		}
+	} while(!logTableBytes.compare_exchange_weak(used, used + bytes));
+
+	bool builtHere = false;
+	std::call_once(slot->built, [&]()
+	{
+		slot->table.store(new GFLogTable(*this), std::memory_order_release);
+		builtHere = true;
+	});
+	if(!builtHere)
+	{
+		logTableBytes -= bytes;
+	}
+	return slot->table.load(std::memory_order_acquire);
+}
+
+
+/**
+ * Sets the memory all log tables together may take. The default is 0, which disables them.
+ * Tables already built are kept.
+ * @param bytes the budget in bytes
+ */
+void GField::setLogTableBudget(const size_t& bytes)
+{
+	logTableBudget = bytes;
+}
+
+
+/**
+ * Returns the memory all log tables together may take
+ * @return the budget in bytes
+ */
+size_t GField::getLogTableBudget()
+{
+	return logTableBudget;
+}
+
+
+/**
+ * Converts a reduced value of this field into Montgomery form a * 2^64 mod p
+ * @param a a number in [0, order)
+ * @return the Montgomery form of a
+ */
+long GField::toMontgomery(const long& a) const
+{
+	assert(hasMontgomery());
+	return _montgomeryReduce((unsigned __int128)a * (unsigned long)_descriptor->montgomeryR2);
+}
+
+
+/**
+ * Converts a value in Montgomery form back into a reduced value of this field
+ * @param a a number in Montgomery form
+ * @return the value represented by a
+ */
+long GField::fromMontgomery(const long& a) const
+{
+	assert(hasMontgomery());
+	return _montgomeryReduce((unsigned long)a);
+}
+
+
+/**
+ * Multiplies two values in Montgomery form without any division
+ * @param a a number in Montgomery form
+ * @param b a number in Montgomery form
+ * @return the Montgomery form of the product
+ */
+long GField::montgomeryMultiply(const long& a, const long& b) const
+{
+	return _montgomeryReduce((unsigned __int128)a * (unsigned long)b);
+}
+
+
+/**
+ * Montgomery reduction (REDC) modulo the order of this field
+ * @param t a number smaller than order * 2^64
+ * @return t * 2^-64 mod p^l
+ */
+long GField::_montgomeryReduce(const unsigned __int128& t) const
+{
+	const unsigned long order = (unsigned long)_descriptor->order;
+	unsigned long m = (unsigned long)t * _descriptor->montgomeryInverse;
+	// t + m * order is divisible by 2^64 and smaller than 2^128 since order < 2^63
+	unsigned long result = (unsigned long)((t + (unsigned __int128)m * order) >> 64);
+	if(result >= order)
+	{
+		result -= order;
+	}
+	return (long)result;
+}
+
+
+/**
+ * Barrett reduction of a 128 bit value modulo the order of this field, using only
+ * multiplications, shifts and at most two subtractions
+ * @param x a number smaller than 2^128
+ * @return x mod p^l
+ */
+long GField::_barrettReduce(const unsigned __int128& x) const
 {
+	return barrettReduce(x, _descriptor->barrettHigh, _descriptor->barrettLow, _descriptor->order);
+}
+
+
+/**
+ * Returns the interned descriptor of the field with the given values, validating them
+ * the first time the pair is seen. Descriptors live until the program exits.
+ * @param p p value of the field
+ * @param l l value of the field
+ * @return descriptor of the field
+ */
+const GField::Descriptor* GField::_intern(long p, const long& l)
+{
+	thread_local const Descriptor *lastSeen = nullptr;
+
+	if(p < 0)
+	{
+		p *= (-1);
+	}
+	if(lastSeen != nullptr && lastSeen->p == p && lastSeen->l == l)
+	{
+		return lastSeen;
+	}
+
+	static std::mutex registryMutex;
+	// never destroyed, so the descriptors and the backends they point to stay valid and
+	// reachable until exit, also for fields used while other statics are destroyed
+	static std::map<std::pair<long, long>, Descriptor> &registry =
+		*new std::map<std::pair<long, long>, Descriptor>();
+
+	std::lock_guard<std::mutex> lock(registryMutex);
+	auto found = registry.find({p, l});
+	if(found == registry.end())
+	{
+		assert(isPrime(p) && l > 0);
+		found = registry.emplace(std::make_pair(p, l), _makeDescriptor(p, l)).first;
+	}
+	lastSeen = &found->second;
+	return lastSeen;
+}
+
 
+/**
+ * Builds the descriptor of a field: computes the order with overflow detection and the
+ * Barrett reduction constants
+ * @param p p value of the field
+ * @param l l value of the field
+ * @return descriptor of the field
+ */
+GField::Descriptor GField::_makeDescriptor(const long& p, const long& l)
+{
+	long order = 1;
+	for(long i = 0; i < l; i++)
+	{
+		bool overflow = __builtin_mul_overflow(order, p, &order);
+		assert(!overflow && "p^l does not fit in a long");
+		(void)overflow;
+	}
 
-	int size = 0;
+	unsigned __int128 mu = ~(unsigned __int128)0 / (unsigned long)order;
 
-	if(p == 2)
+	unsigned long inverse = 0;
+	long r2 = 0;
+	if(l == 1 && (order & 1))
 	{
-		return true;
+		// Newton iteration doubles the number of correct low bits of order^-1 every step
+		inverse = (unsigned long)order;
+		for(int i = 0; i < 5; i++)
+		{
+			inverse *= 2 - (unsigned long)order * inverse;
+		}
+		inverse = 0UL - inverse;
+		long r = (long)((0UL - (unsigned long)order) % (unsigned long)order);
+		r2 = mulMod(r, r, order);
 	}
-	if(p < 2 || p % 2 == 0)
+	// the backends live as long as the descriptor, which is never freed; GF(2^l) gets the
+	// carry-less multiplication of GFBinary instead of the generic polynomial arithmetic
+	const GFBinary *binary = (l > 1 && p == 2) ? new GFBinary((int)l) : nullptr;
+	const GFExtension *extension = (l > 1 && p != 2) ? new GFExtension(p, l) : nullptr;
+	LogTableSlot *logTables = (order <= GFLogTable::MAX_ORDER) ? new LogTableSlot() : nullptr;
+	return Descriptor{p, l, order, (unsigned long)(mu >> 64), (unsigned long)mu, inverse, r2,
+					  extension, binary, logTables};
+}
+
+
+/**
+ * Check if p and l describe a field this class can represent: |p| prime, l positive and
+ * |p|^l fitting in a long; like the constructor, a negative p stands for |p|
+ * @param p p value of the field
+ * @param l l value of the field
+ * @return true if GField(p, l) may be constructed
+ */
+bool GField::isValid(const long& p, const long& l)
+{
+	// -LONG_MIN overflows, and is even anyway
+	const long absolute = (p < 0 && p != LONG_MIN) ? -p : p;
+	if(l <= 0 || !isPrime(absolute))
 	{
 		return false;
 	}
-	long *factors = new long[0];
-	factors = _directSearchFactorization(p, factors, &size);
-	delete[] factors;
-	if(!size)
+	long order = 1;
+	for(long i = 0; i < l; i++)
 	{
-		return true;
+		if(__builtin_mul_overflow(order, absolute, &order))
+		{
+			return false;
+		}
 	}
+	return true;
+}
 
-	return false;
+
+/**
+ * Check if the number p is a prime number
+ * @param p the number
+ * @return true if the number is a prime number
+ */
+bool GField::isPrime(const long& p)
+{
+	FactorStats::add(FactorStats::IS_PRIME_CALLS);
+	FactorStats::Timer timer(FactorStats::IS_PRIME_NANOSECONDS);
+	if(p < PrimeSieve::SMALL_BOUND)
+	{
+		return p >= 0 && PrimeSieve::isSmallPrime(p);
+	}
+	const std::vector<int> &smallPrimes = PrimeSieve::getSmallPrimes();
+	for(int i = 0; i < FILTER_PRIMES; i++)
+	{
+		if(p % smallPrimes[i] == 0)
+		{
+			return false;
+		}
+	}
+	return _millerRabin(p);
+}
+
+
+/**
+ * Returns (a * b) mod m without overflowing, using a 128 bit intermediate
+ * @param a a number in [0, m)
+ * @param b a number in [0, m)
+ * @param m the modulus
+ * @return (a * b) mod m
+ */
+long GField::mulMod(const long& a, const long& b, const long& m)
+{
+	return (long)((unsigned __int128)a * (unsigned long)b % (unsigned long)m);
+}
+
+
+/**
+ * Returns (base ^ exponent) mod m by square and multiply
+ * @param base a number in [0, m)
+ * @param exponent a non negative exponent
+ * @param m the modulus
+ * @return (base ^ exponent) mod m
+ */
+long GField::powMod(long base, long exponent, const long& m)
+{
+	assert(exponent >= 0);
+	long result = 1 % m;
+	while(exponent > 0)
+	{
+		if(exponent & 1)
+		{
+			result = mulMod(result, base, m);
+		}
+		base = mulMod(base, base, m);
+		exponent >>= 1;
+	}
+	return result;
+}
+
+
+/**
+ * Deterministic Miller-Rabin test for every 64 bit number
+ * @param n an odd number with no small prime factors
+ * @return true if n is a prime number
+ */
+bool GField::_millerRabin(const long& n)
+{
+	long d = n - 1;
+	int s = __builtin_ctzl(d);
+	d >>= s;
+
+	for(long witness : MILLER_RABIN_WITNESSES)
+	{
+		long a = witness % n;
+		if(a == 0)
+		{
+			continue;
+		}
+		long x = powMod(a, d, n);
+		if(x == 1 || x == n - 1)
+		{
+			continue;
+		}
+		int i = 1;
+		for(; i < s; i++)
+		{
+			x = mulMod(x, x, n);
+			if(x == n - 1)
+			{
+				break;
+			}
+		}
+		if(i == s)
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
 /**
@@ -164,8 +742,7 @@ bool GField::isPrime(const long& p)
  */
 GFNumber GField::createNumber(const long& k)
 {
-	GField gField(_p, _l);
-	return GFNumber(k, gField);
+	return GFNumber(k, *this);
 }
 
 
@@ -191,87 +768,194 @@ GFNumber GField::gcd(const GFNumber& a, const GFNumber& b)
 long GField::_gcd(const long& a, const long& b)
 {
 	assert(a != 0 || b != 0);
-	return _gcd11(a, b);
+	return gcd(a, b);
 }
 
 
 /**
- * helper function
- * @param a number
- * @param b number
- * @return gcd of two numbers
+ * Returns the gcd of two numbers with Stein's binary algorithm
+ * @param a a number
+ * @param b a number
+ * @return the gcd of |a| and |b|, where gcd(0, b) = |b|
  */
-long GField::_gcd11(long a, long b)
+long GField::gcd(long a, long b)
 {
-	while(a != b)
+	unsigned long u = (a < 0) ? 0UL - (unsigned long)a : (unsigned long)a;
+	unsigned long v = (b < 0) ? 0UL - (unsigned long)b : (unsigned long)b;
+	if(u == 0 || v == 0)
 	{
-		if(a > b)
-		{
-			a -= b ;
-		}
-		else
+		return (long)(u | v);
+	}
+	const int shift = __builtin_ctzl(u | v);
+	u >>= __builtin_ctzl(u);
+	while(v != 0)
+	{
+		v >>= __builtin_ctzl(v);
+		if(u > v)
 		{
-			b -= a;
+			std::swap(u, v);
 		}
+		v -= u;
 	}
-	return a;
+	return (long)(u << shift);
 }
 
 
+/**
+ * Check if a reduced value of this field has a multiplicative inverse
+ * @param a a number in [0, order)
+ * @return true if a is invertible, i.e. a is not zero
+ */
+bool GField::isInvertible(const long& a) const
+{
+	return a != 0;
+}
+
 
 /**
- * direct search factorization algorithm
- * @param n number
- * @param factors prime factors
- * @param size number of prime factors
- * @return prime factors
+ * Returns the multiplicative inverse of a reduced value of this field, using the extended
+ * binary gcd algorithm in GF(p) and a^(p^l - 2) in extension fields. Zero has no inverse;
+ * it is mapped to zero in every field, so dividing by zero gives zero.
+ * @param a a number in [0, order)
+ * @return a^-1 in this field, or 0 if a is 0
  */
-long* GField::_directSearchFactorization(long n, long *factors, int *size)
+long GField::inverse(const long& a) const
 {
-	int i = 2, j = 0;
+	if(!isInvertible(a))
+	{
+		return 0;
+	}
+	if(const GFLogTable *table = getLogTable())
+	{
+		return table->inverse(a);
+	}
+	if(_descriptor->binary != nullptr)
+	{
+		return (long)_descriptor->binary->inverse((unsigned long)a);
+	}
+	if(_descriptor->extension != nullptr)
+	{
+		// the multiplicative group has p^l - 1 elements
+		return power(a, _descriptor->order - 2);
+	}
+	if(_descriptor->p == 2)
+	{
+		return a;
+	}
+	return _binaryInverse(a, _descriptor->p);
+}
 
-	while (i <= floor(sqrt(n)))
+
+/**
+ * Inverts an array of numbers of this field in place with Montgomery's trick, which costs
+ * one inversion and 3(n - 1) multiplications. Zeros are skipped and left unchanged.
+ * @param numbers numbers of this field
+ * @param size number of numbers
+ * @param skipped if not null, receives the positions of the skipped numbers in increasing
+ *        order; it must have room for size positions
+ * @param scratch if not null, a buffer of at least size longs for the prefix products;
+ *        otherwise a buffer owned by the calling thread is reused
+ * @return number of skipped numbers
+ */
+int GField::batchInverse(GFNumber *numbers, const int& size, int *skipped, long *scratch) const
+{
+	thread_local std::vector<long> arena;
+	if(scratch == nullptr)
 	{
-		if(n % i == 0)
+		if(arena.size() < (size_t)size)
 		{
-			long *newFactors = new long[j + 1];
-			for(int k = 0; k < j; k++)
-			{
-				newFactors[k] = factors[k];
-			}
-			delete[] factors;
-			factors = newFactors;
-
+			arena.resize(size);
+		}
+		scratch = arena.data();
+	}
 
-			factors[j] = i;
-			j++;
-			n = (long)(n / floor(i));
+	// scratch[i] = product of the invertible numbers in positions 0..i
+	long product = reduce(1);
+	int skippedCount = 0;
+	for(int i = 0; i < size; i++)
+	{
+		assert(numbers[i].getField().getOrder() == getOrder());
+		const long value = numbers[i].getNumber();
+		if(isInvertible(value))
+		{
+			product = multiply(product, value);
 		}
 		else
 		{
-			i++;
+			if(skipped != nullptr)
+			{
+				skipped[skippedCount] = i;
+			}
+			skippedCount++;
 		}
+		scratch[i] = product;
+	}
+	if(skippedCount == size)
+	{
+		return skippedCount;
 	}
-	if(n > 1)
+
+	// walk back: before position i, accumulated = (product of invertible numbers 0..i)^-1
+	long accumulated = inverse(product);
+	for(int i = size - 1; i >= 0; i--)
 	{
-		long *newFactors = new long[j + 1];
-		for(int k = 0; k < j; k++)
+		const long value = numbers[i].getNumber();
+		if(!isInvertible(value))
 		{
-			newFactors[k] = factors[k];
+			continue;
 		}
-		delete[] factors;
-		factors = newFactors;
+		const long before = (i > 0) ? scratch[i - 1] : reduce(1);
+		numbers[i] = GFNumber(multiply(accumulated, before), *this);
+		accumulated = multiply(accumulated, value);
+	}
+	return skippedCount;
+}
+
 
-		factors[j] = n;
+/**
+ * Extended binary gcd - returns the inverse of a modulo an odd m
+ * @param a a number in [0, m) with gcd(a, m) = 1, or 0
+ * @param m an odd modulus
+ * @return a^-1 mod m, or 0 if a is 0
+ */
+long GField::_binaryInverse(const long& a, const long& m)
+{
+	const unsigned long modulus = (unsigned long)m;
+	// invariants: x1 * a = u (mod m) and x2 * a = v (mod m)
+	unsigned long u = (unsigned long)a, v = modulus, x1 = 1, x2 = 0;
+	if(u % modulus == 0)
+	{
+		// no inverse, and the loop below would never end
+		return 0;
 	}
-	if(j)
+	while(u != 1 && v != 1)
 	{
-		*size = j + 1;
+		while((u & 1) == 0)
+		{
+			u >>= 1;
+			x1 = (x1 & 1) ? (x1 + modulus) >> 1 : x1 >> 1;
+		}
+		while((v & 1) == 0)
+		{
+			v >>= 1;
+			x2 = (x2 & 1) ? (x2 + modulus) >> 1 : x2 >> 1;
+		}
+		if(u >= v)
+		{
+			u -= v;
+			x1 = (x1 >= x2) ? x1 - x2 : x1 + modulus - x2;
+		}
+		else
+		{
+			v -= u;
+			x2 = (x2 >= x1) ? x2 - x1 : x2 + modulus - x1;
+		}
 	}
-	return factors;
+	return (long)((u == 1) ? x1 : x2);
 }
 
 
+
 ////////////////////////////////////////   Operators    ///////////////////////////////////////
 
 /**
@@ -281,8 +965,7 @@ long* GField::_directSearchFactorization(long n, long *factors, int *size)
  */
 GField& GField::operator=(const GField &other)
 {
-	_p = other._p;
-	_l = other._l;
+	_descriptor = other._descriptor;
 	return *this;
 }
 
@@ -294,8 +977,7 @@ GField& GField::operator=(const GField &other)
  */
 bool GField::operator==(const GField &other)
 {
-
-	return (getOrder() == other.getOrder());
+	return (_descriptor == other._descriptor);
 }
 
 
@@ -306,8 +988,7 @@ bool GField::operator==(const GField &other)
  */
 bool GField::operator!=(const GField &other)
 {
-
-	return (getOrder() != other.getOrder());
+	return (_descriptor != other._descriptor);
 }
 
 
@@ -320,7 +1001,7 @@ bool GField::operator!=(const GField &other)
 std::ostream& operator<<(std::ostream &out, const GField &gField)
 
 {
-	out << "GF(" << gField._p << "**" << gField._l << ")";
+	out << "GF(" << gField.getChar() << "**" << gField.getDegree() << ")";
 	return out;
 }
 
@@ -333,8 +1014,9 @@ std::ostream& operator<<(std::ostream &out, const GField &gField)
 */
 std::istream& operator>>(std::istream &in, GField &gField)
 {
-	//I think I should check the values before placing them in the object
-	in >> gField._p >> gField._l;
+	long p, l;
+	in >> p >> l;
+	gField._descriptor = GField::_intern(p, l);
 	return in;
 }
 
@@ -5,14 +5,26 @@
 #include <cassert>
 #include <cmath>
 #include <random>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
 
 
 
 
 class GFNumber;
+class GFExtension;
+class GFBinary;
+class GFLogTable;
 
 /**
- * This class represents a field
+ * This class represents a field.
+ * Every (p, l) pair is validated once and interned in a registry, so a GField is a single
+ * pointer to a shared, immutable descriptor and copying it costs one word copy.
+ * Elements are the values in [0, p^l). For l = 1 they are the integers mod p; for l > 1 they are
+ * polynomials over GF(p) packed as base p digits, and arithmetic is delegated to GFExtension,
+ * or to the carry-less kernels of GFBinary when p = 2.
  */
 class GField
 {
@@ -83,6 +95,106 @@ public:
 	 */
 	const long getOrder() const;
 
+	/**
+	 * Reduces any number into the range [0, order) of this field; a negative k is the additive
+	 * inverse of the element of -k, which only in prime fields is order - (-k mod order)
+	 * @param k a number
+	 * @return the element of k
+	 */
+	long reduce(const long& k) const;
+
+	/**
+	 * Adds two reduced values of this field
+	 * @param a a number in [0, order)
+	 * @param b a number in [0, order)
+	 * @return a + b in this field
+	 */
+	long add(const long& a, const long& b) const;
+
+	/**
+	 * Subtracts two reduced values of this field
+	 * @param a a number in [0, order)
+	 * @param b a number in [0, order)
+	 * @return a - b in this field
+	 */
+	long subtract(const long& a, const long& b) const;
+
+	/**
+	 * Multiplies two reduced values of this field
+	 * @param a a number in [0, order)
+	 * @param b a number in [0, order)
+	 * @return a * b in this field
+	 */
+	long multiply(const long& a, const long& b) const;
+
+	/**
+	 * Raises a reduced value of this field to a power, using left-to-right sliding window
+	 * exponentiation over Montgomery form in odd prime fields
+	 * @param a a number in [0, order)
+	 * @param exponent a non negative exponent
+	 * @return a^exponent in this field
+	 */
+	long power(const long& a, const long& exponent) const;
+
+	/**
+	 * Raises a reduced value of this field to a power with a Montgomery ladder, which runs one
+	 * squaring and one multiplication for every bit of the exponent whatever its value
+	 * @param a a number in [0, order)
+	 * @param exponent a non negative exponent
+	 * @return a^exponent in this field
+	 */
+	long powerLadder(const long& a, const long& exponent) const;
+
+	/**
+	 * Check if Montgomery arithmetic is available in this field, which requires a prime field
+	 * GF(p) with an odd p
+	 * @return true if l = 1 and p is odd
+	 */
+	bool hasMontgomery() const;
+
+	/**
+	 * Returns the log/antilog/Zech tables of this field, building them the first time they are
+	 * asked for. Only fields with order <= 65536 get tables, and only while the memory budget
+	 * allows it; the tables are then used by multiply, inverse and power.
+	 * @return the tables, or null if this field has none
+	 */
+	const GFLogTable* getLogTable() const;
+
+	/**
+	 * Sets the memory all log tables together may take. The default is 0, which disables them.
+	 * Tables already built are kept.
+	 * @param bytes the budget in bytes
+	 */
+	static void setLogTableBudget(const size_t& bytes);
+
+	/**
+	 * Returns the memory all log tables together may take
+	 * @return the budget in bytes
+	 */
+	static size_t getLogTableBudget();
+
+	/**
+	 * Converts a reduced value of this field into Montgomery form a * 2^64 mod p
+	 * @param a a number in [0, order)
+	 * @return the Montgomery form of a
+	 */
+	long toMontgomery(const long& a) const;
+
+	/**
+	 * Converts a value in Montgomery form back into a reduced value of this field
+	 * @param a a number in Montgomery form
+	 * @return the value represented by a
+	 */
+	long fromMontgomery(const long& a) const;
+
+	/**
+	 * Multiplies two values in Montgomery form without any division
+	 * @param a a number in Montgomery form
+	 * @param b a number in Montgomery form
+	 * @return the Montgomery form of the product
+	 */
+	long montgomeryMultiply(const long& a, const long& b) const;
+
 	/**
 	 * Check if the number p is a prime number
 	 * @param p the number
@@ -90,6 +202,62 @@ public:
 	 */
 	static bool isPrime(const long& p);
 
+	/**
+	 * Check if p and l describe a field this class can represent: |p| prime, l positive and
+	 * |p|^l fitting in a long; like the constructor, a negative p stands for |p|
+	 * @param p p value of the field
+	 * @param l l value of the field
+	 * @return true if GField(p, l) may be constructed
+	 */
+	static bool isValid(const long& p, const long& l);
+
+	/**
+	 * Returns (a * b) mod m without overflowing, using a 128 bit intermediate
+	 * @param a a number in [0, m)
+	 * @param b a number in [0, m)
+	 * @param m the modulus
+	 * @return (a * b) mod m
+	 */
+	static long mulMod(const long& a, const long& b, const long& m);
+
+	/**
+	 * Returns (base ^ exponent) mod m by square and multiply
+	 * @param base a number in [0, m)
+	 * @param exponent a non negative exponent
+	 * @param m the modulus
+	 * @return (base ^ exponent) mod m
+	 */
+	static long powMod(long base, long exponent, const long& m);
+
+	/**
+	 * Barrett reduction of a 128 bit value, using only multiplications, shifts and at most two
+	 * subtractions; shared by GField and the constant modulus of GFNumberT
+	 * @param x a number smaller than 2^128
+	 * @param muHigh high word of the reciprocal floor((2^128 - 1) / order)
+	 * @param muLow low word of the reciprocal
+	 * @param order the modulus
+	 * @return x mod order
+	 */
+	static constexpr long barrettReduce(const unsigned __int128& x, const unsigned long& muHigh,
+										const unsigned long& muLow, const long& order)
+	{
+		const unsigned long xHigh = (unsigned long)(x >> 64), xLow = (unsigned long)x;
+
+		// q = floor(x * mu / 2^128), assembled from four 64x64 bit products
+		unsigned __int128 lowCross = ((unsigned __int128)xLow * muLow) >> 64;
+		lowCross += (unsigned __int128)xHigh * muLow;
+		unsigned __int128 highCross = (unsigned __int128)xLow * muHigh + (unsigned long)lowCross;
+		unsigned __int128 q = (unsigned __int128)xHigh * muHigh + (unsigned long)(lowCross >> 64) +
+							  (unsigned long)(highCross >> 64);
+
+		unsigned __int128 r = x - q * (unsigned long)order;
+		while(r >= (unsigned long)order)
+		{
+			r -= order;
+		}
+		return (long)r;
+	}
+
 	/**
 	 * Creates a number in this field with the value k
 	 * @param k the value of the number
@@ -106,6 +274,44 @@ public:
 	 */
 	GFNumber gcd(const GFNumber& a, const GFNumber& b);
 
+	/**
+	 * Returns the gcd of two numbers with Stein's binary algorithm
+	 * @param a a number
+	 * @param b a number
+	 * @return the gcd of |a| and |b|, where gcd(0, b) = |b|
+	 */
+	static long gcd(long a, long b);
+
+	/**
+	 * Check if a reduced value of this field has a multiplicative inverse
+	 * @param a a number in [0, order)
+	 * @return true if a is invertible, i.e. a is not zero
+	 */
+	bool isInvertible(const long& a) const;
+
+	/**
+	 * Returns the multiplicative inverse of a reduced value of this field, using the extended
+	 * binary gcd algorithm in GF(p) and a^(p^l - 2) in extension fields. Zero has no inverse;
+	 * it is mapped to zero in every field, so dividing by zero gives zero.
+	 * @param a a number in [0, order)
+	 * @return a^-1 in this field, or 0 if a is 0
+	 */
+	long inverse(const long& a) const;
+
+	/**
+	 * Inverts an array of numbers of this field in place with Montgomery's trick, which costs
+	 * one inversion and 3(n - 1) multiplications. Zeros are skipped and left unchanged.
+	 * @param numbers numbers of this field
+	 * @param size number of numbers
+	 * @param skipped if not null, receives the positions of the skipped numbers in increasing
+	 *        order; it must have room for size positions
+	 * @param scratch if not null, a buffer of at least size longs for the prefix products;
+	 *        otherwise a buffer owned by the calling thread is reused
+	 * @return number of skipped numbers
+	 */
+	int batchInverse(GFNumber *numbers, const int& size, int *skipped = nullptr,
+					 long *scratch = nullptr) const;
+
 
 
 
@@ -151,18 +357,93 @@ public:
 
 private:
 
-	long _p;  // char of this field
+	friend class GFLogTable;
 
-	long _l;  // degree of this field
+	/**
+	 * Lazily built log tables of a field, built at most once
+	 */
+	struct LogTableSlot
+	{
+		std::once_flag built;  // guards the construction
+
+		std::atomic<const GFLogTable*> table;  // the tables, null until built
+	};
 
 	/**
-     * direct search factorization algorithm
-     * @param n number
-     * @param factors prime factors
-     * @param size number of prime factors
-     * @return prime factors
-     */
-	static long* _directSearchFactorization(long n, long *factors, int *size);
+	 * Immutable description of a field, shared by every GField with the same p and l
+	 */
+	struct Descriptor
+	{
+		long p;  // char of the field
+
+		long l;  // degree of the field
+
+		long order;  // p^l, computed exactly
+
+		unsigned long barrettHigh;  // high word of the Barrett reciprocal floor((2^128 - 1) / order)
+
+		unsigned long barrettLow;   // low word of the Barrett reciprocal
+
+		unsigned long montgomeryInverse;  // -order^-1 mod 2^64, when the order is odd
+
+		long montgomeryR2;  // 2^128 mod order, when the order is odd
+
+		const GFExtension *extension;  // polynomial arithmetic when l > 1 and p != 2, otherwise null
+
+		const GFBinary *binary;  // carry-less arithmetic when l > 1 and p = 2, otherwise null
+
+		LogTableSlot *logTables;  // log tables when order <= 65536, otherwise null
+	};
+
+	const Descriptor *_descriptor;  // interned description of this field
+
+	/**
+	 * Returns the interned descriptor of the field with the given values, validating them
+	 * the first time the pair is seen. Descriptors live until the program exits.
+	 * @param p p value of the field
+	 * @param l l value of the field
+	 * @return descriptor of the field
+	 */
+	static const Descriptor* _intern(long p, const long& l);
+
+	/**
+	 * Builds the descriptor of a field: computes the order with overflow detection and the
+	 * Barrett reduction constants
+	 * @param p p value of the field
+	 * @param l l value of the field
+	 * @return descriptor of the field
+	 */
+	static Descriptor _makeDescriptor(const long& p, const long& l);
+
+	/**
+	 * Barrett reduction of a 128 bit value modulo the order of this field, using only
+	 * multiplications, shifts and at most two subtractions
+	 * @param x a number smaller than 2^128
+	 * @return x mod p^l
+	 */
+	long _barrettReduce(const unsigned __int128& x) const;
+
+	/**
+	 * Multiplies two reduced values of this field without the log tables
+	 * @param a a number in [0, order)
+	 * @param b a number in [0, order)
+	 * @return a * b in this field
+	 */
+	long _multiplyDirect(const long& a, const long& b) const;
+
+	/**
+	 * Montgomery reduction (REDC) modulo the order of this field
+	 * @param t a number smaller than order * 2^64
+	 * @return t * 2^-64 mod p^l
+	 */
+	long _montgomeryReduce(const unsigned __int128& t) const;
+
+	/**
+	 * Deterministic Miller-Rabin test for every 64 bit number
+	 * @param n an odd number with no small prime factors
+	 * @return true if n is a prime number
+	 */
+	static bool _millerRabin(const long& n);
 
 	/**
      * Helper function
@@ -173,12 +454,12 @@ private:
 	long _gcd(const long& a, const long& b);
 
 	/**
-	 * helper function
-	 * @param a number
-	 * @param b number
-	 * @return gcd of two numbers
+	 * Extended binary gcd - returns the inverse of a modulo an odd m
+	 * @param a a number in [0, m) with gcd(a, m) = 1, or 0
+	 * @param m an odd modulus
+	 * @return a^-1 mod m, or 0 if a is 0
 	 */
-	long _gcd11(long a, long b);
+	static long _binaryInverse(const long& a, const long& m);
 };
 
 #endif //EX1_GFIELD_H
@@ -1,24 +1,152 @@
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <thread>
 #include "GFNumber.h"
 #include "GField.h"
+#include "BatchFactorizer.h"
+#include "GFParser.h"
+#include "GFFormatter.h"
+#include "FactorStats.h"
+#include "FactorCache.h"
 #include <cassert>
+#include <memory>
 
 /**
- * The main function of this program
+ * Prints how the program is run
+ * @param name the name of the program
+ */
+static void printUsage(const char *name)
+{
+	std::cerr << "usage: " << name << " [--batch [file]] [--threads n] [--window chunks]"
+			  << " [--rho-threads n] [--cache megabytes] [--compact] [--stats]" << std::endl;
+}
+
+
+/**
+ * Prints the factorization statistics, and the counts of the cache if any, to the standard error
+ */
+static void printStats()
+{
+	const FactorCache *cache = GFNumber::getFactorCache();
+	if(cache != nullptr)
+	{
+		std::cerr << "cache_hits: " << cache->getHits() << '\n' << "cache_misses: " << cache->getMisses()
+				  << '\n' << "cache_entries: " << cache->getEntries() << '\n' << "cache_bytes: "
+				  << cache->getBytes() << '\n';
+	}
+	if(!FactorStats::isEnabled())
+	{
+		std::cerr << "statistics are compiled out, build with -DGF_ENABLE_STATS" << std::endl;
+		return;
+	}
+	FactorStats::collect().print(std::cerr);
+}
+
+
+/**
+ * The main function of this program. Without arguments it reads two numbers, prints their sum,
+ * differences and product and factors both; with --batch it factors every line of the file,
+ * or of the standard input, on a pool of threads
  * @return
  */
-int main()
+int main(int argc, char *argv[])
 {
+	bool batch = false;
+	const char *file = nullptr;
+	int threads = std::max(1, (int)std::thread::hardware_concurrency());
+	int window = BatchFactorizer::DEFAULT_WINDOW;
+	bool compact = false;
+	bool stats = false;
+	std::unique_ptr<FactorCache> cache;
+	for(int i = 1; i < argc; i++)
+	{
+		if(std::strcmp(argv[i], "--batch") == 0)
+		{
+			batch = true;
+			if(i + 1 < argc && std::strncmp(argv[i + 1], "--", 2) != 0)
+			{
+				file = argv[++i];
+			}
+		}
+		else if(std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+		{
+			threads = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--window") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+		{
+			window = std::atoi(argv[++i]);
+		}
+		else if(std::strcmp(argv[i], "--rho-threads") == 0 && i + 1 < argc && std::atoi(argv[i + 1]) > 0)
+		{
+			GFNumber::setRhoThreads(std::atoi(argv[++i]));
+		}
+		else if(std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc && std::atol(argv[i + 1]) > 0)
+		{
+			cache.reset(new FactorCache((size_t)std::atol(argv[++i]) << 20));
+			GFNumber::setFactorCache(cache.get());
+		}
+		else if(std::strcmp(argv[i], "--compact") == 0)
+		{
+			compact = true;
+		}
+		else if(std::strcmp(argv[i], "--stats") == 0)
+		{
+			stats = true;
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if(batch)
+	{
+		std::ios::sync_with_stdio(false);
+		const int descriptor = (file == nullptr) ? STDIN_FILENO : open(file, O_RDONLY);
+		if(descriptor < 0)
+		{
+			std::cerr << "cannot open " << file << std::endl;
+			return 1;
+		}
+		GFParser parser(descriptor);
+		BatchFactorizer factorizer(threads, window);
+		factorizer.setCompact(compact);
+		factorizer.run(parser, std::cout);
+		if(file != nullptr)
+		{
+			close(descriptor);
+		}
+		if(stats)
+		{
+			printStats();
+		}
+		return 0;
+	}
+
 	GFNumber num1, num2;
-	std::cin>>num1>>num2;
+	if(!(std::cin>>num1>>num2))
+	{
+		std::cerr << "invalid input" << std::endl;
+		return 1;
+	}
 	assert(num1.getField().getOrder() ==  num2.getField().getOrder());
-	std::cout << num1 + num2 << std::endl;
-	std::cout << num1 - num2 << std::endl;
-	std::cout << num2 - num1 << std::endl;
-	std::cout << num1 * num2 << std::endl;
-	num1.printFactors();
-	num2.printFactors();
-
+	GFFormatter out(std::cout);
+	out.setCompact(compact);
+	out.append(num1 + num2).append('\n');
+	out.append(num1 - num2).append('\n');
+	out.append(num2 - num1).append('\n');
+	out.append(num1 * num2).append('\n');
+	num1.printFactors(out);
+	num2.printFactors(out);
+	out.flush();
+	if(stats)
+	{
+		printStats();
+	}
 
 	return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,208 @@
+#include "MontgomeryNumber.h"
+
+
+////////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+
+/**
+ * Default constructor - the zero of the field GF(3**1)
+ */
+MontgomeryNumber::MontgomeryNumber():_m(0), _gField(3, 1)
+{
+
+}
+
+
+/**
+ * Constructor #1
+ * @param number a number of GF(p) with an odd p
+ */
+MontgomeryNumber::MontgomeryNumber(const GFNumber &number):_gField(number.getField())
+{
+	_m = _gField.toMontgomery(number.getNumber());
+}
+
+
+/**
+ * Constructor #2
+ * @param n a number in the given field
+ * @param field the field GF(p) with an odd p
+ */
+MontgomeryNumber::MontgomeryNumber(const long &n, const GField &field):_gField(field)
+{
+	_m = _gField.toMontgomery(_gField.reduce(n));
+}
+
+
+/**
+ * Copy constructor
+ * @param other another number
+ */
+MontgomeryNumber::MontgomeryNumber(const MontgomeryNumber &other):_m(other._m), _gField(other._gField)
+{
+
+}
+
+
+/**
+ * Destructor
+ */
+MontgomeryNumber::~MontgomeryNumber() = default;
+
+
+
+////////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+/**
+ * Converts this number back into a regular number of the field
+ * @return the number represented by this object
+ */
+GFNumber MontgomeryNumber::toGFNumber() const
+{
+	return GFNumber(getNumber(), _gField);
+}
+
+
+/**
+ * Function returns the value of the number represented by this class
+ * @return value of the number, out of Montgomery form
+ */
+long MontgomeryNumber::getNumber() const
+{
+	return _gField.fromMontgomery(_m);
+}
+
+
+/**
+ * Function returns the field of this number
+ * @return field of this number
+ */
+const GField& MontgomeryNumber::getField() const
+{
+	return _gField;
+}
+
+
+
+////////////////////////////////////////   Operators    ///////////////////////////////////////
+
+/**
+ * Overload '=' operator to place one MontgomeryNumber into another
+ * @param other The MontgomeryNumber object to be placed in this object
+ * @return A reference to this object after the other number was placed into it
+ */
+MontgomeryNumber& MontgomeryNumber::operator=(const MontgomeryNumber &other)
+{
+	_m = other._m;
+	_gField = other._gField;
+	return *this;
+}
+
+
+/**
+ * Overload '+' operator to add two MontgomeryNumber objects
+ * @param other The right number to be added to this number
+ * @return The result of the addition
+ */
+MontgomeryNumber MontgomeryNumber::operator+(const MontgomeryNumber &other) const
+{
+	MontgomeryNumber result(*this);
+	return result += other;
+}
+
+
+/**
+ * Overload '+=' operator to add a MontgomeryNumber object to this object
+ * @param other The number to be added to this object
+ * @return This object after the addition
+ */
+MontgomeryNumber& MontgomeryNumber::operator+=(const MontgomeryNumber &other)
+{
+	assert(_gField.getOrder() == other._gField.getOrder());
+	_m = _gField.add(_m, other._m);
+	return *this;
+}
+
+
+/**
+ * Overload '-' operator to subtract two MontgomeryNumber objects
+ * @param other The right number to be subtracted from this number
+ * @return The result of the subtraction
+ */
+MontgomeryNumber MontgomeryNumber::operator-(const MontgomeryNumber &other) const
+{
+	MontgomeryNumber result(*this);
+	return result -= other;
+}
+
+
+/**
+ * Overload '-=' operator to subtract a MontgomeryNumber object from this object
+ * @param other The number to be subtracted from this object
+ * @return This object after the subtraction
+ */
+MontgomeryNumber& MontgomeryNumber::operator-=(const MontgomeryNumber &other)
+{
+	assert(_gField.getOrder() == other._gField.getOrder());
+	_m = _gField.subtract(_m, other._m);
+	return *this;
+}
+
+
+/**
+ * Overload '*' operator to multiply two MontgomeryNumber objects
+ * @param other The right number to be multiplied with this number
+ * @return The result of the multiplication
+ */
+MontgomeryNumber MontgomeryNumber::operator*(const MontgomeryNumber &other) const
+{
+	MontgomeryNumber result(*this);
+	return result *= other;
+}
+
+
+/**
+ * Overload '*=' operator to multiply this object by another MontgomeryNumber object
+ * @param other The number to multiply this object by
+ * @return This object after the multiplication
+ */
+MontgomeryNumber& MontgomeryNumber::operator*=(const MontgomeryNumber &other)
+{
+	assert(_gField.getOrder() == other._gField.getOrder());
+	_m = _gField.montgomeryMultiply(_m, other._m);
+	return *this;
+}
+
+
+/**
+ * Overload '==' operator to check if two MontgomeryNumber objects are equal
+ * @param other A number from some field
+ * @return True if the numbers are equal. Otherwise, false.
+ */
+bool MontgomeryNumber::operator==(const MontgomeryNumber &other) const
+{
+	return (_m == other._m && _gField.getOrder() == other._gField.getOrder());
+}
+
+
+/**
+ * Overload '!=' operator to check if two MontgomeryNumber objects are not equal
+ * @param other A number from some field
+ * @return True if the numbers are not equal. Otherwise, false.
+ */
+bool MontgomeryNumber::operator!=(const MontgomeryNumber &other) const
+{
+	return !(*this == other);
+}
+
+
+/**
+ * Overload '<<' operator to print the number in the format "{n} GF(p**l)"
+ * @param out A reference to the output
+ * @param number the number to be printed
+ * @return the output containing the value of number
+ */
+std::ostream& operator<<(std::ostream &out, const MontgomeryNumber &number)
+{
+	out << number.toGFNumber();
+	return out;
+}
@@ -0,0 +1,151 @@
+#ifndef EX1_MONTGOMERYNUMBER_H
+#define EX1_MONTGOMERYNUMBER_H
+
+#include "GFNumber.h"
+#include "GField.h"
+#include <iostream>
+
+/**
+ * This class represents a number of a prime field GF(p) with an odd p, kept in Montgomery form
+ * (n * 2^64 mod p). A number is converted once, chains of multiplications then run without
+ * any division, and the value is converted back only when it is read or printed.
+ */
+class MontgomeryNumber
+{
+
+public:
+
+	////////////////////////////////////  Constructors & Destructor  //////////////////////////////
+	/**
+	 * Default constructor - the zero of the field GF(3**1)
+	 */
+	MontgomeryNumber();
+
+	/**
+	 * Constructor #1
+	 * @param number a number of GF(p) with an odd p
+	 */
+	explicit MontgomeryNumber(const GFNumber &number);
+
+	/**
+	 * Constructor #2
+	 * @param n a number in the given field
+	 * @param field the field GF(p) with an odd p
+	 */
+	MontgomeryNumber(const long &n, const GField &field);
+
+	/**
+	 * Copy constructor
+	 * @param other another number
+	 */
+	MontgomeryNumber(const MontgomeryNumber &other);
+
+	/**
+	 * Destructor
+	 */
+	~MontgomeryNumber();
+
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Converts this number back into a regular number of the field
+	 * @return the number represented by this object
+	 */
+	GFNumber toGFNumber() const;
+
+	/**
+	 * Function returns the value of the number represented by this class
+	 * @return value of the number, out of Montgomery form
+	 */
+	long getNumber() const;
+
+	/**
+	 * Function returns the field of this number
+	 * @return field of this number
+	 */
+	const GField& getField() const;
+
+
+	///////////////////////////////////   Operators   /////////////////////////////////////////////
+
+	/**
+	 * Overload '=' operator to place one MontgomeryNumber into another
+	 * @param other The MontgomeryNumber object to be placed in this object
+	 * @return A reference to this object after the other number was placed into it
+	 */
+	MontgomeryNumber& operator=(const MontgomeryNumber &other);
+
+	/**
+	 * Overload '+' operator to add two MontgomeryNumber objects
+	 * @param other The right number to be added to this number
+	 * @return The result of the addition
+	 */
+	MontgomeryNumber operator+(const MontgomeryNumber &other) const;
+
+	/**
+	 * Overload '+=' operator to add a MontgomeryNumber object to this object
+	 * @param other The number to be added to this object
+	 * @return This object after the addition
+	 */
+	MontgomeryNumber& operator+=(const MontgomeryNumber &other);
+
+	/**
+	 * Overload '-' operator to subtract two MontgomeryNumber objects
+	 * @param other The right number to be subtracted from this number
+	 * @return The result of the subtraction
+	 */
+	MontgomeryNumber operator-(const MontgomeryNumber &other) const;
+
+	/**
+	 * Overload '-=' operator to subtract a MontgomeryNumber object from this object
+	 * @param other The number to be subtracted from this object
+	 * @return This object after the subtraction
+	 */
+	MontgomeryNumber& operator-=(const MontgomeryNumber &other);
+
+	/**
+	 * Overload '*' operator to multiply two MontgomeryNumber objects
+	 * @param other The right number to be multiplied with this number
+	 * @return The result of the multiplication
+	 */
+	MontgomeryNumber operator*(const MontgomeryNumber &other) const;
+
+	/**
+	 * Overload '*=' operator to multiply this object by another MontgomeryNumber object
+	 * @param other The number to multiply this object by
+	 * @return This object after the multiplication
+	 */
+	MontgomeryNumber& operator*=(const MontgomeryNumber &other);
+
+	/**
+	 * Overload '==' operator to check if two MontgomeryNumber objects are equal
+	 * @param other A number from some field
+	 * @return True if the numbers are equal. Otherwise, false.
+	 */
+	bool operator==(const MontgomeryNumber &other) const;
+
+	/**
+	 * Overload '!=' operator to check if two MontgomeryNumber objects are not equal
+	 * @param other A number from some field
+	 * @return True if the numbers are not equal. Otherwise, false.
+	 */
+	bool operator!=(const MontgomeryNumber &other) const;
+
+	/**
+	 * Overload '<<' operator to print the number in the format "{n} GF(p**l)"
+	 * @param out A reference to the output
+	 * @param number the number to be printed
+	 * @return the output containing the value of number
+	 */
+	friend std::ostream& operator<<(std::ostream &out, const MontgomeryNumber &number);
+
+
+private:
+
+	long _m;             // the value of the number in Montgomery form
+	GField _gField;      // the field of the number
+};
+
+
+#endif //EX1_MONTGOMERYNUMBER_H
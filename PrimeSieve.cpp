@@ -0,0 +1,351 @@
+#include "PrimeSieve.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+const long PrimeSieve::SMALL_BOUND;
+const long PrimeSieve::MAX_LIMIT;
+
+// residues mod 30 of the numbers coprime to 30; byte i holds 30i + RESIDUES[j] in bit j
+static const int RESIDUES[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+// bit of every residue mod 30, -1 for the residues sharing a factor with 30
+static const int BITS[30] = {-1, 0, -1, -1, -1, -1, -1, 1, -1, -1, -1, 2, -1, 3, -1, -1, -1, 4, -1, 5,
+							 -1, -1, -1, 6, -1, -1, -1, -1, -1, 7};
+
+// distance from every residue mod 30 to the next residue coprime to 30
+static const int OFFSETS[30] = {1, 0, 5, 4, 3, 2, 1, 0, 3, 2, 1, 0, 1, 0, 3, 2, 1, 0, 1, 0, 3, 2, 1, 0, 5, 4, 3,
+								2, 1, 0};
+
+// distance from RESIDUES[j] to the next number coprime to 30
+static const int GAPS[8] = {6, 4, 2, 4, 2, 4, 6, 2};
+
+// bytes of a segment, the size of a typical L1 data cache
+static const long SEGMENT_BYTES = 32 * 1024;
+
+// work of sieving one segment, in the units of ThreadPool::THREAD_WORK
+static const long SEGMENT_WORK = 30 * SEGMENT_BYTES;
+
+// segments each thread sieves before primesInRange hands their primes to the callback
+static const long ROUND_SEGMENTS = 8;
+
+
+/**
+ * The primes below SMALL_BOUND, as a list and as a wheel bitmap
+ */
+struct SmallTable
+{
+	std::vector<unsigned char> bits;  // one byte per 30 numbers, a set bit for every prime
+
+	std::vector<int> primes;          // the primes, in increasing order
+};
+
+
+/**
+ * Sieves a segment: clears the bit of every multiple of a sieving prime, from its square up
+ * @param bits receives one byte per 30 numbers, a set bit for every number coprime to 30 left
+ * @param firstByte index of the first byte; the segment starts at 30 * firstByte
+ * @param bytes number of bytes of the segment
+ * @param primes the sieving primes, from 7 up in increasing order
+ */
+static void sieveSegment(unsigned char *bits, const long &firstByte, const long &bytes,
+						 const std::vector<int> &primes)
+{
+	memset(bits, 0xFF, bytes);
+	const long low = 30 * firstByte;
+	const long high = 30 * (firstByte + bytes);
+	for(const int p : primes)
+	{
+		if((long)p * p >= high)
+		{
+			break;
+		}
+		// multiples p * k with k coprime to 30 fall on one bit each, p bytes apart; the first
+		// multiples of the eight bits come from eight consecutive such k, so once one of them
+		// is past the segment the rest are too
+		long k = std::max((long)p, (low + p - 1) / p);
+		k += OFFSETS[k % 30];
+		for(int j = 0; j < 8; j++)
+		{
+			const long multiple = p * k;
+			long i = multiple / 30 - firstByte;
+			if(i >= bytes)
+			{
+				break;
+			}
+			const unsigned char mask = (unsigned char)~(1 << BITS[multiple % 30]);
+			for(; i < bytes; i += p)
+			{
+				bits[i] &= mask;
+			}
+			k += GAPS[BITS[k % 30]];
+		}
+	}
+	if(firstByte == 0)
+	{
+		// 1 is not prime
+		bits[0] &= (unsigned char)~1;
+	}
+}
+
+
+/**
+ * Calls a function with every number of a sieved segment which is left and in a range
+ * @param bits the sieved segment
+ * @param firstByte index of the first byte; the segment starts at 30 * firstByte
+ * @param bytes number of bytes of the segment
+ * @param a start of the range
+ * @param b end of the range, excluded
+ * @param function called with every number left, in increasing order
+ */
+template<typename Function>
+static void forEachLeft(const unsigned char *bits, const long &firstByte, const long &bytes, const long &a,
+						const long &b, Function function)
+{
+	for(long i = 0; i < bytes; i += 8)
+	{
+		unsigned long word = 0;
+		memcpy(&word, bits + i, (size_t)std::min(8L, bytes - i));
+		while(word != 0)
+		{
+			const int bit = __builtin_ctzl(word);
+			const long n = 30 * (firstByte + i + (bit >> 3)) + RESIDUES[bit & 7];
+			if(n >= a && n < b)
+			{
+				function(n);
+			}
+			word &= word - 1;
+		}
+	}
+}
+
+
+/**
+ * Counts the numbers of a sieved segment which are left and in a range
+ * @param bits the sieved segment
+ * @param firstByte index of the first byte; the segment starts at 30 * firstByte
+ * @param bytes number of bytes of the segment
+ * @param a start of the range
+ * @param b end of the range, excluded
+ * @return number of numbers left
+ */
+static long countLeft(const unsigned char *bits, const long &firstByte, const long &bytes, const long &a,
+					  const long &b)
+{
+	long count = 0;
+	for(long i = 0; i < bytes; i += 8)
+	{
+		unsigned long word = 0;
+		memcpy(&word, bits + i, (size_t)std::min(8L, bytes - i));
+		count += __builtin_popcountl(word);
+	}
+	// only the first and the last byte may hold numbers outside the range
+	const long edges[2] = {0, bytes - 1};
+	for(int e = 0; e < ((bytes > 1) ? 2 : 1); e++)
+	{
+		for(int bit = 0; bit < 8; bit++)
+		{
+			const long n = 30 * (firstByte + edges[e]) + RESIDUES[bit];
+			if(((bits[edges[e]] >> bit) & 1) && (n < a || n >= b))
+			{
+				count--;
+			}
+		}
+	}
+	return count;
+}
+
+
+/**
+ * Returns the primes, from 7 up, which sieve a range ending at b: at least every prime p with
+ * p * p < b
+ * @param b end of the range, excluded
+ * @return the sieving primes, in increasing order
+ */
+static std::vector<int> sievingPrimes(const long &b)
+{
+	const long root = (long)std::sqrt((double)b) + 1;
+	std::vector<int> primes;
+	if(root < PrimeSieve::SMALL_BOUND)
+	{
+		for(const int p : PrimeSieve::getSmallPrimes())
+		{
+			if(p > root)
+			{
+				break;
+			}
+			if(p >= 7)
+			{
+				primes.push_back(p);
+			}
+		}
+		return primes;
+	}
+	PrimeSieve::primesInRange(7, root + 1, [&primes](const long &p)
+	{
+		primes.push_back((int)p);
+	});
+	return primes;
+}
+
+
+/**
+ * Sieves the small prime table
+ * @return the table
+ */
+static SmallTable buildSmallTable()
+{
+	// the sieving primes below the square root of SMALL_BOUND, by trial division
+	std::vector<int> sieving;
+	for(int n = 7; (long)n * n < PrimeSieve::SMALL_BOUND; n += 2)
+	{
+		bool prime = true;
+		for(int d = 3; d * d <= n && prime; d += 2)
+		{
+			prime = (n % d != 0);
+		}
+		if(prime)
+		{
+			sieving.push_back(n);
+		}
+	}
+	SmallTable table;
+	const long bytes = PrimeSieve::SMALL_BOUND / 30 + 1;
+	table.bits.resize(bytes);
+	sieveSegment(table.bits.data(), 0, bytes, sieving);
+	table.primes = {2, 3, 5};
+	forEachLeft(table.bits.data(), 0, bytes, 0, PrimeSieve::SMALL_BOUND, [&table](const long &p)
+	{
+		table.primes.push_back((int)p);
+	});
+	return table;
+}
+
+
+/**
+ * Returns the small prime table, sieved on first use
+ * @return the table
+ */
+static const SmallTable& smallTable()
+{
+	static const SmallTable table = buildSmallTable();
+	return table;
+}
+
+
+////////////////////////////////////   Class Methods    ///////////////////////////////////////////
+
+/**
+ * Calls a function with every prime in a range, in increasing order, on the calling thread
+ * @param a start of the range
+ * @param b end of the range, excluded, at most MAX_LIMIT
+ * @param callback called with every prime p, a <= p < b
+ */
+void PrimeSieve::primesInRange(const long &a, const long &b, const std::function<void(const long&)> &callback)
+{
+	assert(b <= MAX_LIMIT);
+	const long start = std::max(a, 0L);
+	for(const long p : {2L, 3L, 5L})
+	{
+		if(p >= start && p < b)
+		{
+			callback(p);
+		}
+	}
+	if(b <= std::max(start, 7L))
+	{
+		return;
+	}
+	const std::vector<int> primes = sievingPrimes(b);
+	const long firstByte = start / 30;
+	const long endByte = (b + 29) / 30;
+	// each round sieves ROUND_SEGMENTS segments per thread, then hands over their primes
+	const long roundBytes = ThreadPool::getThreads() * ROUND_SEGMENTS * SEGMENT_BYTES;
+	std::vector<unsigned char> bits((size_t)std::min(roundBytes, endByte - firstByte));
+	for(long round = firstByte; round < endByte; round += roundBytes)
+	{
+		const long roundEnd = std::min(endByte, round + roundBytes);
+		const long segments = (roundEnd - round + SEGMENT_BYTES - 1) / SEGMENT_BYTES;
+		ThreadPool::parallelFor(segments, SEGMENT_WORK, [&](const int &, const long &begin, const long &end)
+		{
+			for(long s = begin; s < end; s++)
+			{
+				const long first = round + s * SEGMENT_BYTES;
+				sieveSegment(bits.data() + s * SEGMENT_BYTES, first, std::min(SEGMENT_BYTES, roundEnd - first),
+							 primes);
+			}
+		});
+		forEachLeft(bits.data(), round, roundEnd - round, start, b, callback);
+	}
+}
+
+
+/**
+ * Counts the primes in a range
+ * @param a start of the range
+ * @param b end of the range, excluded, at most MAX_LIMIT
+ * @return number of primes p, a <= p < b
+ */
+long PrimeSieve::countPrimes(const long &a, const long &b)
+{
+	assert(b <= MAX_LIMIT);
+	const long start = std::max(a, 0L);
+	long count = 0;
+	for(const long p : {2L, 3L, 5L})
+	{
+		count += (p >= start && p < b);
+	}
+	if(b <= std::max(start, 7L))
+	{
+		return count;
+	}
+	const std::vector<int> primes = sievingPrimes(b);
+	const long firstByte = start / 30;
+	const long endByte = (b + 29) / 30;
+	const long segments = (endByte - firstByte + SEGMENT_BYTES - 1) / SEGMENT_BYTES;
+	std::atomic<long> total(count);
+	ThreadPool::parallelFor(segments, SEGMENT_WORK, [&](const int &, const long &begin, const long &end)
+	{
+		std::vector<unsigned char> bits(SEGMENT_BYTES);
+		long local = 0;
+		for(long s = begin; s < end; s++)
+		{
+			const long first = firstByte + s * SEGMENT_BYTES;
+			const long bytes = std::min(SEGMENT_BYTES, endByte - first);
+			sieveSegment(bits.data(), first, bytes, primes);
+			local += countLeft(bits.data(), first, bytes, start, b);
+		}
+		total += local;
+	});
+	return total.load();
+}
+
+
+/**
+ * Returns the primes below SMALL_BOUND, sieved on first use
+ * @return the primes, in increasing order
+ */
+const std::vector<int>& PrimeSieve::getSmallPrimes()
+{
+	return smallTable().primes;
+}
+
+
+/**
+ * Check if a number below SMALL_BOUND is prime, by a lookup in the small prime table
+ * @param n a number in [0, SMALL_BOUND)
+ * @return true if n is prime
+ */
+bool PrimeSieve::isSmallPrime(const long &n)
+{
+	assert(n >= 0 && n < SMALL_BOUND);
+	if(n < 7)
+	{
+		return n == 2 || n == 3 || n == 5;
+	}
+	const int bit = BITS[n % 30];
+	return bit >= 0 && ((smallTable().bits[n / 30] >> bit) & 1);
+}
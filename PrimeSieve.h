@@ -0,0 +1,58 @@
+#ifndef EX1_PRIMESIEVE_H
+#define EX1_PRIMESIEVE_H
+
+#include <functional>
+#include <vector>
+
+/**
+ * This class enumerates primes with a segmented sieve of Eratosthenes. The numbers coprime to 30
+ * are packed eight to a byte, one byte per 30 numbers, and a range is sieved in segments which
+ * fit the L1 cache; the segments of a range are split over ThreadPool::getThreads() threads.
+ * Memory is bounded by the primes below the square root of the range end and a few segments
+ * per thread.
+ * The primes below SMALL_BOUND are sieved once into a table which the primality test and
+ * trial division of GField and GFNumber use.
+ */
+class PrimeSieve
+{
+
+public:
+
+	static const long SMALL_BOUND = 1L << 16;  // the small prime table holds the primes below this
+
+	static const long MAX_LIMIT = 1L << 48;    // ranges end at most here
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Calls a function with every prime in a range, in increasing order, on the calling thread
+	 * @param a start of the range
+	 * @param b end of the range, excluded, at most MAX_LIMIT
+	 * @param callback called with every prime p, a <= p < b
+	 */
+	static void primesInRange(const long &a, const long &b, const std::function<void(const long&)> &callback);
+
+	/**
+	 * Counts the primes in a range
+	 * @param a start of the range
+	 * @param b end of the range, excluded, at most MAX_LIMIT
+	 * @return number of primes p, a <= p < b
+	 */
+	static long countPrimes(const long &a, const long &b);
+
+	/**
+	 * Returns the primes below SMALL_BOUND, sieved on first use
+	 * @return the primes, in increasing order
+	 */
+	static const std::vector<int>& getSmallPrimes();
+
+	/**
+	 * Check if a number below SMALL_BOUND is prime, by a lookup in the small prime table
+	 * @param n a number in [0, SMALL_BOUND)
+	 * @return true if n is prime
+	 */
+	static bool isSmallPrime(const long &n);
+};
+
+
+#endif //EX1_PRIMESIEVE_H
@@ -0,0 +1,172 @@
+#include "ThreadPool.h"
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const long ThreadPool::THREAD_WORK;
+
+// number of threads parallel loops may use
+static std::atomic<int> threadCount(std::max(1, (int)std::thread::hardware_concurrency()));
+
+
+/**
+ * The workers and the loop they run
+ */
+struct Pool
+{
+	std::atomic<bool> busy{false};        // whether a loop runs on the pool
+
+	std::mutex mutex;                     // guards the members below
+
+	std::condition_variable started;      // a loop was started
+
+	std::condition_variable finished;     // every chunk of the loop finished
+
+	std::vector<std::thread> workers;     // the workers, started as loops need them
+
+	long generation = 0;                  // number of loops started
+
+	void (*task)(void*, const int&) = nullptr;  // runs one chunk of the loop
+
+	void *context = nullptr;              // passed to the task
+
+	int chunks = 0;                       // number of chunks of the loop
+
+	std::atomic<unsigned long> next{0};   // the loop in the high half, its next chunk in the low
+
+	int pending = 0;                      // chunks not finished yet
+};
+
+
+/**
+ * Returns the pool, built on first use
+ * @return the pool
+ */
+static Pool& pool()
+{
+	static Pool *instance = new Pool();  // never destroyed, the workers sleep in it until exit
+	return *instance;
+}
+
+
+/**
+ * Runs the chunks of a loop until none is left. A chunk is claimed only while the loop is
+ * still the current one, so a worker waking late never runs a chunk of the next loop.
+ * @param shared the pool
+ * @param generation the loop
+ * @param task runs one chunk of the loop
+ * @param context passed to the task
+ * @param chunks number of chunks of the loop
+ * @return number of chunks run
+ */
+static int runChunks(Pool &shared, const long &generation, void (*task)(void*, const int&), void *context,
+					 const int &chunks)
+{
+	int done = 0;
+	unsigned long next = shared.next.load();
+	while((long)(next >> 32) == (generation & 0xFFFFFFFFL) && (int)(next & 0xFFFFFFFFUL) < chunks)
+	{
+		if(shared.next.compare_exchange_weak(next, next + 1))
+		{
+			task(context, (int)(next & 0xFFFFFFFFUL));
+			done++;
+			next = shared.next.load();
+		}
+	}
+	return done;
+}
+
+
+/**
+ * The loop of a worker: waits for a loop, helps running it, and waits again
+ */
+static void work()
+{
+	Pool &shared = pool();
+	long seen = 0;
+	std::unique_lock<std::mutex> lock(shared.mutex);
+	while(true)
+	{
+		shared.started.wait(lock, [&]{ return shared.generation != seen; });
+		seen = shared.generation;
+		void (*task)(void*, const int&) = shared.task;
+		void *context = shared.context;
+		const int chunks = shared.chunks;
+		lock.unlock();
+		const int done = runChunks(shared, seen, task, context, chunks);
+		lock.lock();
+		shared.pending -= done;
+		if(done > 0 && shared.pending == 0)
+		{
+			shared.finished.notify_one();
+		}
+	}
+}
+
+
+////////////////////////////////////   Class Methods    ///////////////////////////////////////////
+
+/**
+ * Sets the number of threads parallel loops may use
+ * @param threads number of threads, at least 1
+ */
+void ThreadPool::setThreads(const int &threads)
+{
+	assert(threads >= 1);
+	threadCount.store(threads);
+}
+
+
+/**
+ * Returns the number of threads parallel loops may use; the default is the number of
+ * hardware threads
+ * @return number of threads
+ */
+int ThreadPool::getThreads()
+{
+	return threadCount.load();
+}
+
+
+/**
+ * Runs chunks on the pool and the calling thread, and waits for all of them
+ * @param chunks number of chunks
+ * @param task runs one chunk
+ * @param context passed to the task
+ */
+void ThreadPool::_run(const int &chunks, Task task, void *context)
+{
+	Pool &shared = pool();
+	if(shared.busy.exchange(true))
+	{
+		// the pool runs another loop, maybe the one this call comes from
+		for(int index = 0; index < chunks; index++)
+		{
+			task(context, index);
+		}
+		return;
+	}
+	std::unique_lock<std::mutex> lock(shared.mutex);
+	while((int)shared.workers.size() < chunks - 1)
+	{
+		shared.workers.emplace_back(work);
+	}
+	shared.task = task;
+	shared.context = context;
+	shared.chunks = chunks;
+	shared.pending = chunks;
+	const long generation = ++shared.generation;
+	shared.next = (unsigned long)(generation & 0xFFFFFFFFL) << 32;
+	lock.unlock();
+	shared.started.notify_all();
+
+	const int done = runChunks(shared, generation, task, context, chunks);
+	lock.lock();
+	shared.pending -= done;
+	shared.finished.wait(lock, [&]{ return shared.pending == 0; });
+	lock.unlock();
+	shared.busy = false;
+}
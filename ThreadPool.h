@@ -0,0 +1,104 @@
+#ifndef EX1_THREADPOOL_H
+#define EX1_THREADPOOL_H
+
+#include <algorithm>
+
+/**
+ * This class runs loops over a range on a pool of threads which is started once and kept for
+ * the whole run, so a parallel loop costs a wake up rather than a thread start. The range is
+ * split into contiguous chunks, at most one per thread; the calling thread runs chunks too. A
+ * loop started while another one runs, for example from inside a chunk, runs on the calling
+ * thread alone. The number of threads is shared by the matrices and the prime sieve.
+ */
+class ThreadPool
+{
+
+public:
+
+	static const long THREAD_WORK = 1L << 16;  // smallest amount of work worth a thread of its own
+
+	////////////////////////////////////   Class Methods    ///////////////////////////////////////
+
+	/**
+	 * Runs a function over a range split into contiguous chunks, one per thread, and waits for
+	 * every chunk
+	 * @param count size of the range
+	 * @param workPerItem cost of one item, in the units of THREAD_WORK
+	 * @param function called with the index of the chunk and its bounds [begin, end)
+	 * @return number of chunks
+	 */
+	template<typename Function>
+	static int parallelFor(const long &count, const long &workPerItem, Function function)
+	{
+		if(count <= 0)
+		{
+			return 0;
+		}
+		long threads = std::min((long)getThreads(), count * std::max(workPerItem, 1L) / THREAD_WORK);
+		threads = std::max(1L, std::min(threads, count));
+		const long chunk = (count + threads - 1) / threads;
+		const int chunks = (int)((count + chunk - 1) / chunk);
+		if(chunks == 1)
+		{
+			function(0, 0L, count);
+			return 1;
+		}
+		Loop<Function> loop{function, count, chunk};
+		_run(chunks, &Loop<Function>::runChunk, &loop);
+		return chunks;
+	}
+
+	/**
+	 * Sets the number of threads parallel loops may use
+	 * @param threads number of threads, at least 1
+	 */
+	static void setThreads(const int &threads);
+
+	/**
+	 * Returns the number of threads parallel loops may use; the default is the number of
+	 * hardware threads
+	 * @return number of threads
+	 */
+	static int getThreads();
+
+
+private:
+
+	typedef void (*Task)(void *context, const int &index);  // runs one chunk of a loop
+
+	/**
+	 * A loop of parallelFor, which runs its chunks
+	 */
+	template<typename Function>
+	struct Loop
+	{
+		Function &function;  // the body of the loop
+
+		long count;          // size of the range
+
+		long chunk;          // size of a chunk
+
+		/**
+		 * Runs one chunk of a loop
+		 * @param context the loop
+		 * @param index index of the chunk
+		 */
+		static void runChunk(void *context, const int &index)
+		{
+			Loop &loop = *(Loop*)context;
+			const long begin = index * loop.chunk;
+			loop.function(index, begin, std::min(loop.count, begin + loop.chunk));
+		}
+	};
+
+	/**
+	 * Runs chunks on the pool and the calling thread, and waits for all of them
+	 * @param chunks number of chunks
+	 * @param task runs one chunk
+	 * @param context passed to the task
+	 */
+	static void _run(const int &chunks, Task task, void *context);
+};
+
+
+#endif //EX1_THREADPOOL_H